@@ -0,0 +1,21 @@
+TEMPLATE = app
+
+QT = core testlib
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+TARGET = ModelBenchmark
+
+SOURCES += main.cpp \
+	benchobject.cpp \
+	benchgadget.cpp \
+	tst_modelbenchmark.cpp
+
+HEADERS += \
+	benchobject.h \
+	benchgadget.h \
+	tst_modelbenchmark.h
+
+include(../qobjectlistmodel.pri)
@@ -0,0 +1,14 @@
+#include "benchgadget.h"
+
+BenchGadget::BenchGadget(int id) :
+	id(id),
+	name(QStringLiteral("Gadget %1").arg(id)),
+	ratio(id / 10.0)
+{}
+
+bool BenchGadget::operator==(const BenchGadget &other) const
+{
+	return id == other.id &&
+			name == other.name &&
+			qFuzzyCompare(ratio, other.ratio);
+}
@@ -0,0 +1,24 @@
+#ifndef BENCHGADGET_H
+#define BENCHGADGET_H
+
+#include <QObject>
+
+class BenchGadget
+{
+	Q_GADGET
+
+	Q_PROPERTY(int id MEMBER id)
+	Q_PROPERTY(QString name MEMBER name)
+	Q_PROPERTY(double ratio MEMBER ratio)
+
+public:
+	BenchGadget(int id = -1);
+
+	int id;
+	QString name;
+	double ratio;
+
+	bool operator==(const BenchGadget &other) const;
+};
+
+#endif // BENCHGADGET_H
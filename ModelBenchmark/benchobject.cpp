@@ -0,0 +1,54 @@
+#include "benchobject.h"
+
+BenchObject::BenchObject(QObject *parent) :
+	BenchObject{0, parent}
+{}
+
+BenchObject::BenchObject(int value, QObject *parent) :
+	QObject(parent),
+	_name(QStringLiteral("Object %1").arg(value)),
+	_value(value),
+	_ratio(value / 10.0)
+{}
+
+QString BenchObject::name() const
+{
+	return _name;
+}
+
+int BenchObject::value() const
+{
+	return _value;
+}
+
+double BenchObject::ratio() const
+{
+	return _ratio;
+}
+
+void BenchObject::setName(QString name)
+{
+	if (_name == name)
+		return;
+
+	_name = name;
+	emit nameChanged(_name);
+}
+
+void BenchObject::setValue(int value)
+{
+	if (_value == value)
+		return;
+
+	_value = value;
+	emit valueChanged(_value);
+}
+
+void BenchObject::setRatio(double ratio)
+{
+	if (qFuzzyCompare(_ratio, ratio))
+		return;
+
+	_ratio = ratio;
+	emit ratioChanged(_ratio);
+}
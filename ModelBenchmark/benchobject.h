@@ -0,0 +1,38 @@
+#ifndef BENCHOBJECT_H
+#define BENCHOBJECT_H
+
+#include <QObject>
+
+class BenchObject : public QObject
+{
+	Q_OBJECT
+
+	Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+	Q_PROPERTY(int value READ value WRITE setValue NOTIFY valueChanged)
+	Q_PROPERTY(double ratio READ ratio WRITE setRatio NOTIFY ratioChanged)
+
+public:
+	explicit BenchObject(QObject *parent = nullptr);
+	BenchObject(int value, QObject *parent = nullptr);
+
+	QString name() const;
+	int value() const;
+	double ratio() const;
+
+public slots:
+	void setName(QString name);
+	void setValue(int value);
+	void setRatio(double ratio);
+
+signals:
+	void nameChanged(QString name);
+	void valueChanged(int value);
+	void ratioChanged(double ratio);
+
+private:
+	QString _name;
+	int _value;
+	double _ratio;
+};
+
+#endif // BENCHOBJECT_H
@@ -0,0 +1,30 @@
+#include <algorithm>
+#include <QCoreApplication>
+#include <QtTest>
+#include "tst_modelbenchmark.h"
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	ModelBenchmark benchmark;
+
+	// default to csv output, so results can be compared by scripts
+	static const QStringList formatArgs {
+		QStringLiteral("-o"),
+		QStringLiteral("-txt"),
+		QStringLiteral("-csv"),
+		QStringLiteral("-xml"),
+		QStringLiteral("-lightxml"),
+		QStringLiteral("-xunitxml"),
+		QStringLiteral("-teamcity"),
+		QStringLiteral("-tap")
+	};
+	auto args = app.arguments();
+	const auto hasFormat = std::any_of(args.begin(), args.end(), [](const QString &arg) {
+		return formatArgs.contains(arg);
+	});
+	if(!hasFormat)
+		args.insert(1, QStringLiteral("-csv"));
+
+	return QTest::qExec(&benchmark, args);
+}
@@ -0,0 +1,408 @@
+#include "tst_modelbenchmark.h"
+#include <cstdlib>
+#include <new>
+#include <QtTest>
+#include <qgenericlistmodel.h>
+#include <qobjectproxymodel.h>
+#include <qobjectsortfilterproxymodel.h>
+
+namespace {
+
+const int BatchSize = 1000;
+const int DataRows = 10000;
+
+QAtomicInt allocationCount;
+
+// counts the heap allocations of a single call, after a first call warmed up any caches
+template <typename TFunc>
+int allocationsOf(const TFunc &func)
+{
+	func();
+	const auto before = allocationCount.loadAcquire();
+	func();
+	return allocationCount.loadAcquire() - before;
+}
+
+}
+
+// replaced for the whole benchmark, so allocation free code paths can be verified
+void *operator new(std::size_t size)
+{
+	allocationCount.fetchAndAddRelaxed(1);
+	if(const auto ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+ModelBenchmark::ModelBenchmark(QObject *parent) :
+	QObject{parent}
+{}
+
+void ModelBenchmark::objectData_data()
+{
+	addRoleNames({"name", "value", "ratio"});
+}
+
+void ModelBenchmark::objectData()
+{
+	QFETCH(QByteArray, roleName);
+
+	QGenericListModel<BenchObject> model;
+	model.addObjects(createObjects(DataRows));
+	const auto role = model.roleNames().key(roleName);
+	const auto index = model.index(DataRows / 2, 0);
+
+	QBENCHMARK {
+		model.data(index, role);
+	}
+}
+
+void ModelBenchmark::addObject_data()
+{
+	addRowCounts({1000, 10000, 100000, 1000000});
+}
+
+void ModelBenchmark::addObject()
+{
+	QFETCH(int, rows);
+
+	const auto objects = createObjects(rows);
+	QBENCHMARK_ONCE {
+		QGenericListModel<BenchObject> model{false};
+		for(auto obj : objects)
+			model.addObject(obj);
+	}
+	qDeleteAll(objects);
+}
+
+void ModelBenchmark::addObjects_data()
+{
+	addRowCounts({1000, 10000, 100000, 1000000});
+}
+
+void ModelBenchmark::addObjects()
+{
+	QFETCH(int, rows);
+
+	const auto objects = createObjects(rows);
+	QBENCHMARK_ONCE {
+		QGenericListModel<BenchObject> model{false};
+		model.addObjects(objects);
+	}
+	qDeleteAll(objects);
+}
+
+void ModelBenchmark::insertObject_data()
+{
+	addRowCounts({1000, 10000, 100000, 1000000});
+}
+
+void ModelBenchmark::insertObject()
+{
+	QFETCH(int, rows);
+
+	QGenericListModel<BenchObject> model;
+	model.addObjects(createObjects(rows));
+	const auto batch = createObjects(BatchSize);
+	// inserts a fixed batch into the middle, to measure the cost per row depending on the model size
+	QBENCHMARK_ONCE {
+		for(auto obj : batch)
+			model.insertObject(rows / 2, obj);
+	}
+}
+
+void ModelBenchmark::removeObject_data()
+{
+	addRowCounts({1000, 10000, 100000, 1000000});
+}
+
+void ModelBenchmark::removeObject()
+{
+	QFETCH(int, rows);
+
+	QGenericListModel<BenchObject> model;
+	model.addObjects(createObjects(rows + BatchSize));
+	QBENCHMARK_ONCE {
+		for(auto i = 0; i < BatchSize; ++i)
+			model.removeObject(rows / 2);
+	}
+}
+
+void ModelBenchmark::recycleObject_data()
+{
+	QTest::addColumn<int>("poolLimit");
+	QTest::newRow("deleteLater") << 0;
+	QTest::newRow("pooled") << BatchSize;
+}
+
+void ModelBenchmark::recycleObject()
+{
+	QFETCH(int, poolLimit);
+
+	QGenericListModel<BenchObject> model;
+	model.setPoolLimit(poolLimit);
+	model.setRecycleHook([](BenchObject *object) {
+		object->setValue(0);
+	});
+	model.addObjects(createObjects(BatchSize));
+	QBENCHMARK {
+		for(auto i = 0; i < BatchSize; ++i) {
+			model.removeObject(0);
+			model.addObject(model.acquireObject());
+		}
+	}
+}
+
+void ModelBenchmark::propertyChange_data()
+{
+	addRowCounts({1000, 10000, 100000, 1000000});
+}
+
+void ModelBenchmark::propertyChange()
+{
+	QFETCH(int, rows);
+
+	QGenericListModel<BenchObject> model;
+	const auto objects = createObjects(rows);
+	model.addObjects(objects);
+	auto changes = 0;
+	connect(&model, &QAbstractItemModel::dataChanged,
+			this, [&changes]() {
+		++changes;
+	});
+
+	// the last row is the worst case for a linear row lookup
+	auto obj = objects.last();
+	auto value = 0;
+	QBENCHMARK {
+		obj->setValue(++value);
+	}
+	QVERIFY(changes > 0);
+}
+
+void ModelBenchmark::aliasDataChanged_data()
+{
+	QTest::addColumn<int>("columns");
+	QTest::newRow("1") << 1;
+	QTest::newRow("10") << 10;
+	QTest::newRow("30") << 30;
+}
+
+void ModelBenchmark::aliasDataChanged()
+{
+	QFETCH(int, columns);
+
+	static const QList<const char*> roleNames {"name", "value", "ratio"};
+	QGenericListModel<BenchObject> model;
+	const auto objects = createObjects(DataRows);
+	model.addObjects(objects);
+	for(auto column = 0; column < columns; ++column)
+		model.addColumn(QStringLiteral("Column %1").arg(column), roleNames[column % roleNames.size()]);
+
+	auto obj = objects[DataRows / 2];
+	auto value = 0;
+	QBENCHMARK {
+		obj->setValue(++value);
+	}
+}
+
+void ModelBenchmark::proxyData_data()
+{
+	QTest::addColumn<int>("column");
+	QTest::newRow("0") << 0;
+	QTest::newRow("1") << 1;
+	QTest::newRow("2") << 2;
+}
+
+void ModelBenchmark::proxyData()
+{
+	QFETCH(int, column);
+
+	QGenericListModel<BenchObject> model;
+	model.addObjects(createObjects(DataRows));
+	QObjectProxyModel proxy{{QStringLiteral("Name"), QStringLiteral("Value"), QStringLiteral("Ratio")}};
+	proxy.setSourceModel(&model);
+	proxy.addRole(0, Qt::DisplayRole, "name");
+	proxy.addRole(1, Qt::DisplayRole, "value");
+	proxy.addRole(2, Qt::DisplayRole, "ratio");
+	const auto index = proxy.index(DataRows / 2, column);
+
+	QBENCHMARK {
+		proxy.data(index, Qt::DisplayRole);
+	}
+}
+
+void ModelBenchmark::converterRead_data()
+{
+	QTest::addColumn<bool>("srcConverter");
+	QTest::addColumn<bool>("aliasConverter");
+	QTest::newRow("none") << false << false;
+	QTest::newRow("src") << true << false;
+	QTest::newRow("alias") << false << true;
+	QTest::newRow("both") << true << true;
+}
+
+void ModelBenchmark::converterRead()
+{
+	QFETCH(bool, srcConverter);
+	QFETCH(bool, aliasConverter);
+
+	QGenericListModel<BenchObject> model;
+	model.addObjects(createObjects(DataRows));
+	QObjectProxyModel proxy{{QStringLiteral("Value")}};
+	proxy.setSourceModel(&model);
+	proxy.addRole(0, Qt::DisplayRole, "value");
+	if(srcConverter)
+		proxy.addSrcConverter(model.roleNames().key("value"), [](int value) {
+			return value * 2;
+		});
+	if(aliasConverter)
+		proxy.addAliasConverter(0, Qt::DisplayRole, [](int value) {
+			return value + 1.5;
+		});
+	const auto index = proxy.index(DataRows / 2, 0);
+
+	// converters must not add any allocations to a read
+	QObjectProxyModel plainProxy{{QStringLiteral("Value")}};
+	plainProxy.setSourceModel(&model);
+	plainProxy.addRole(0, Qt::DisplayRole, "value");
+	const auto plainIndex = plainProxy.index(DataRows / 2, 0);
+	QCOMPARE(allocationsOf([&]() { proxy.data(index, Qt::DisplayRole); }),
+			 allocationsOf([&]() { plainProxy.data(plainIndex, Qt::DisplayRole); }));
+
+	QBENCHMARK {
+		proxy.data(index, Qt::DisplayRole);
+	}
+}
+
+void ModelBenchmark::sortProxyUpdate_data()
+{
+	addRowCounts({1000, 10000, 50000});
+}
+
+void ModelBenchmark::sortProxyUpdate()
+{
+	QFETCH(int, rows);
+
+	QGenericListModel<BenchObject> model;
+	const auto objects = createObjects(rows);
+	model.addObjects(objects);
+	QObjectSortFilterProxyModel proxy;
+	proxy.setSourceModel(&model);
+	proxy.setSortRole(model.roleNames().key("value"));
+	proxy.sort(0);
+
+	// jumps between both ends of the sort order, so every update moves the row
+	auto obj = objects[rows / 2];
+	QBENCHMARK {
+		obj->setValue(obj->value() < 0 ? rows : -1);
+	}
+}
+
+void ModelBenchmark::gadgetRead_data()
+{
+	addRoleNames({"id", "name", "ratio"});
+}
+
+void ModelBenchmark::gadgetRead()
+{
+	QFETCH(QByteArray, roleName);
+
+	QGenericListModel<BenchGadget> model;
+	model.addGadgets(createGadgets(DataRows));
+	const auto role = model.roleNames().key(roleName);
+	const auto index = model.index(DataRows / 2, 0);
+
+	QBENCHMARK {
+		model.data(index, role);
+	}
+}
+
+void ModelBenchmark::gadgetBoundRead_data()
+{
+	QTest::addColumn<QString>("binding");
+	QTest::newRow("property") << QStringLiteral("property");
+	QTest::newRow("member") << QStringLiteral("member");
+	QTest::newRow("static") << QStringLiteral("static");
+}
+
+void ModelBenchmark::gadgetBoundRead()
+{
+	QFETCH(QString, binding);
+
+	QGenericListModel<BenchGadget> model;
+	model.addGadgets(createGadgets(DataRows));
+	const auto role = model.roleNames().key("ratio");
+	if(binding == QStringLiteral("member"))
+		model.bindMember(role, &BenchGadget::ratio);
+	else if(binding == QStringLiteral("static"))
+		model.bindMember<double, &BenchGadget::ratio>(role);
+	const auto index = model.index(DataRows / 2, 0);
+
+	QBENCHMARK {
+		model.data(index, role);
+	}
+}
+
+void ModelBenchmark::gadgetWrite_data()
+{
+	addRoleNames({"id", "name", "ratio"});
+}
+
+void ModelBenchmark::gadgetWrite()
+{
+	QFETCH(QByteArray, roleName);
+
+	QGenericListModel<BenchGadget> model;
+	model.setEditable(true);
+	model.addGadgets(createGadgets(DataRows));
+	const auto role = model.roleNames().key(roleName);
+	const auto index = model.index(DataRows / 2, 0);
+	const auto data = model.data(index, role);
+
+	QBENCHMARK {
+		model.setData(index, data, role);
+	}
+}
+
+void ModelBenchmark::addRowCounts(std::initializer_list<int> counts)
+{
+	QTest::addColumn<int>("rows");
+	for(auto count : counts)
+		QTest::newRow(QByteArray::number(count).constData()) << count;
+}
+
+void ModelBenchmark::addRoleNames(const QList<QByteArray> &roleNames)
+{
+	QTest::addColumn<QByteArray>("roleName");
+	for(const auto &roleName : roleNames)
+		QTest::newRow(roleName.constData()) << roleName;
+}
+
+QList<BenchObject*> ModelBenchmark::createObjects(int count)
+{
+	QList<BenchObject*> objects;
+	objects.reserve(count);
+	for(auto i = 0; i < count; ++i)
+		objects.append(new BenchObject{i});
+	return objects;
+}
+
+QList<BenchGadget> ModelBenchmark::createGadgets(int count)
+{
+	QList<BenchGadget> gadgets;
+	gadgets.reserve(count);
+	for(auto i = 0; i < count; ++i)
+		gadgets.append(BenchGadget{i});
+	return gadgets;
+}
@@ -0,0 +1,52 @@
+#ifndef TST_MODELBENCHMARK_H
+#define TST_MODELBENCHMARK_H
+
+#include <QObject>
+#include "benchobject.h"
+#include "benchgadget.h"
+
+class ModelBenchmark : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit ModelBenchmark(QObject *parent = nullptr);
+
+private Q_SLOTS:
+	void objectData_data();
+	void objectData();
+	void addObject_data();
+	void addObject();
+	void addObjects_data();
+	void addObjects();
+	void insertObject_data();
+	void insertObject();
+	void removeObject_data();
+	void removeObject();
+	void recycleObject_data();
+	void recycleObject();
+	void propertyChange_data();
+	void propertyChange();
+	void aliasDataChanged_data();
+	void aliasDataChanged();
+	void proxyData_data();
+	void proxyData();
+	void converterRead_data();
+	void converterRead();
+	void sortProxyUpdate_data();
+	void sortProxyUpdate();
+	void gadgetRead_data();
+	void gadgetRead();
+	void gadgetBoundRead_data();
+	void gadgetBoundRead();
+	void gadgetWrite_data();
+	void gadgetWrite();
+
+private:
+	static void addRowCounts(std::initializer_list<int> counts);
+	static void addRoleNames(const QList<QByteArray> &roleNames);
+	static QList<BenchObject*> createObjects(int count);
+	static QList<BenchGadget> createGadgets(int count);
+};
+
+#endif // TST_MODELBENCHMARK_H
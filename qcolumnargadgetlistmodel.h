@@ -0,0 +1,444 @@
+#ifndef QCOLUMNARGADGETLISTMODEL_H
+#define QCOLUMNARGADGETLISTMODEL_H
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+
+#include <QtCore/QHash>
+#include <QtCore/QPair>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+#include "qmetaobjectmodel.h"
+
+template <typename TGadget>
+class QColumnarGadgetListModel : public QMetaObjectModel
+{
+public:
+	explicit QColumnarGadgetListModel(QObject *parent = nullptr);
+
+	QList<TGadget> gadgets() const;
+	TGadget gadget(const QModelIndex &index) const;
+	TGadget gadget(int index) const;
+	void addGadget(const TGadget &gadget);
+	void insertGadget(int index, const TGadget &gadget);
+	void addGadgets(const QList<TGadget> &gadgets);
+	void insertGadgets(int index, const QList<TGadget> &gadgets);
+	void removeGadget(const QModelIndex &index);
+	void removeGadget(int index);
+	void removeGadgets(int first, int count);
+	TGadget takeGadget(int index);
+	TGadget replaceGadget(int index, const TGadget &gadget);
+	void resetModel(const QList<TGadget> &gadgets);
+
+	template <typename TValue>
+	void bindColumn(int role, TValue TGadget::*member);
+	template <typename TValue>
+	inline void bindColumn(const char *roleName, TValue TGadget::*member);
+
+	template <typename TValue>
+	const QVector<TValue> &column(TValue TGadget::*member) const;
+	template <typename TValue>
+	const TValue &value(int row, TValue TGadget::*member) const;
+	template <typename TValue>
+	void setValue(int row, TValue TGadget::*member, TValue value);
+	template <typename TValue, typename TLessThan = std::less<TValue>>
+	void sortBy(TValue TGadget::*member, Qt::SortOrder order = Qt::AscendingOrder, TLessThan lessThan = {});
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+protected:
+	QVariant readProperty(int row, const QMetaProperty &property) const override;
+	bool writeProperty(int row, const QMetaProperty &property, const QVariant &data) override;
+	bool concurrentReads() const override;
+
+private:
+	class Column {
+	public:
+		virtual ~Column() = default;
+
+		virtual void insert(int row, const QList<TGadget> &gadgets) = 0;
+		virtual void remove(int first, int count) = 0;
+		virtual void clear() = 0;
+		virtual void permute(const QVector<int> &order) = 0;
+		virtual QVariant read(int row) const = 0;
+		virtual bool write(int row, const QVariant &data) = 0;
+		virtual void load(int row, TGadget &gadget) const = 0;
+		virtual void store(int row, const TGadget &gadget) = 0;
+	};
+
+	class VariantColumn : public Column {
+	public:
+		inline VariantColumn(QMetaProperty property) :
+			property{std::move(property)}
+		{}
+
+		void insert(int row, const QList<TGadget> &gadgets) override {
+			values.insert(row, gadgets.size(), QVariant{});
+			for(auto i = 0; i < gadgets.size(); ++i)
+				values[row + i] = property.readOnGadget(&gadgets[i]);
+		}
+		void remove(int first, int count) override {
+			values.remove(first, count);
+		}
+		void clear() override {
+			values.clear();
+		}
+		void permute(const QVector<int> &order) override {
+			QVector<QVariant> sorted;
+			sorted.reserve(order.size());
+			for(auto row : order)
+				sorted.append(values[row]);
+			values.swap(sorted);
+		}
+		QVariant read(int row) const override {
+			return values[row];
+		}
+		bool write(int row, const QVariant &data) override {
+			// same checks as writeOnGadget, so the stored value always has the property type
+			if(!property.isWritable())
+				return false;
+			auto value = data;
+			if(value.userType() != property.userType() &&
+			   !value.convert(property.userType()))
+				return false;
+			values[row] = std::move(value);
+			return true;
+		}
+		void load(int row, TGadget &gadget) const override {
+			property.writeOnGadget(&gadget, values[row]);
+		}
+		void store(int row, const TGadget &gadget) override {
+			values[row] = property.readOnGadget(&gadget);
+		}
+
+		const QMetaProperty property;
+		QVector<QVariant> values;
+	};
+
+	template <typename TValue>
+	class MemberColumn : public Column {
+	public:
+		inline MemberColumn(TValue TGadget::*member) :
+			member{member}
+		{}
+
+		void insert(int row, const QList<TGadget> &gadgets) override {
+			values.insert(row, gadgets.size(), TValue{});
+			for(auto i = 0; i < gadgets.size(); ++i)
+				values[row + i] = gadgets[i].*member;
+		}
+		void remove(int first, int count) override {
+			values.remove(first, count);
+		}
+		void clear() override {
+			values.clear();
+		}
+		void permute(const QVector<int> &order) override {
+			QVector<TValue> sorted;
+			sorted.reserve(order.size());
+			for(auto row : order)
+				sorted.append(values[row]);
+			values.swap(sorted);
+		}
+		QVariant read(int row) const override {
+			return QVariant::fromValue(values[row]);
+		}
+		bool write(int row, const QVariant &data) override {
+			if(!data.canConvert<TValue>())
+				return false;
+			values[row] = data.value<TValue>();
+			return true;
+		}
+		void load(int row, TGadget &gadget) const override {
+			gadget.*member = values[row];
+		}
+		void store(int row, const TGadget &gadget) override {
+			values[row] = gadget.*member;
+		}
+
+		TValue TGadget::* const member;
+		QVector<TValue> values;
+	};
+
+	using MemberKey = QPair<const void*, qint64>; // member type tag, member pointer bits
+
+	QVector<QSharedPointer<Column>> _storage; // index: role - Qt::UserRole - 1
+	QHash<MemberKey, int> _memberColumns; // value: index in _storage
+	int _rowCount = 0;
+
+	template <typename TValue>
+	static MemberKey memberKey(TValue TGadget::*member);
+	template <typename TValue>
+	int columnIndex(TValue TGadget::*member) const;
+	void permuteRows(const QVector<int> &order);
+};
+
+// ------------- Generic Implementation
+
+template<typename TGadget>
+QColumnarGadgetListModel<TGadget>::QColumnarGadgetListModel(QObject *parent) :
+	QMetaObjectModel{&TGadget::staticMetaObject, parent}
+{
+	_storage.reserve(roleProperties().size());
+	for(const auto &property : roleProperties())
+		_storage.append(QSharedPointer<Column>{new VariantColumn{property}});
+}
+
+template<typename TGadget>
+QList<TGadget> QColumnarGadgetListModel<TGadget>::gadgets() const
+{
+	QList<TGadget> list;
+	list.reserve(_rowCount);
+	for(auto row = 0; row < _rowCount; ++row)
+		list.append(gadget(row));
+	return list;
+}
+
+template<typename TGadget>
+TGadget QColumnarGadgetListModel<TGadget>::gadget(const QModelIndex &index) const
+{
+	Q_ASSERT(checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid));
+	return gadget(index.row());
+}
+
+template<typename TGadget>
+TGadget QColumnarGadgetListModel<TGadget>::gadget(int index) const
+{
+	Q_ASSERT_X(index >= 0 && index < _rowCount, Q_FUNC_INFO, "index out of range");
+	TGadget gadget;
+	for(const auto &column : _storage)
+		column->load(index, gadget);
+	return gadget;
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::addGadget(const TGadget &gadget)
+{
+	insertGadgets(_rowCount, {gadget});
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::insertGadget(int index, const TGadget &gadget)
+{
+	insertGadgets(index, {gadget});
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::addGadgets(const QList<TGadget> &gadgets)
+{
+	insertGadgets(_rowCount, gadgets);
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::insertGadgets(int index, const QList<TGadget> &gadgets)
+{
+	if(gadgets.isEmpty())
+		return;
+
+	beginInsertRows(QModelIndex{}, index, index + gadgets.size() - 1);
+	for(const auto &column : qAsConst(_storage))
+		column->insert(index, gadgets);
+	_rowCount += gadgets.size();
+	endInsertRows();
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::removeGadget(const QModelIndex &index)
+{
+	Q_ASSERT(checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid));
+	removeGadget(index.row());
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::removeGadget(int index)
+{
+	removeGadgets(index, 1);
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::removeGadgets(int first, int count)
+{
+	if(count <= 0)
+		return;
+
+	beginRemoveRows(QModelIndex{}, first, first + count - 1);
+	for(const auto &column : qAsConst(_storage))
+		column->remove(first, count);
+	_rowCount -= count;
+	endRemoveRows();
+}
+
+template<typename TGadget>
+TGadget QColumnarGadgetListModel<TGadget>::takeGadget(int index)
+{
+	const auto oldGad = gadget(index);
+	removeGadgets(index, 1);
+	return oldGad;
+}
+
+template<typename TGadget>
+TGadget QColumnarGadgetListModel<TGadget>::replaceGadget(int index, const TGadget &gadget)
+{
+	const auto oldGad = this->gadget(index);
+	for(const auto &column : qAsConst(_storage))
+		column->store(index, gadget);
+	emitDataChanged(this->index(index, 0), this->index(index, 0), {});
+	return oldGad;
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::resetModel(const QList<TGadget> &gadgets)
+{
+	beginResetModel();
+	for(const auto &column : qAsConst(_storage)) {
+		column->clear();
+		column->insert(0, gadgets);
+	}
+	_rowCount = gadgets.size();
+	endResetModel();
+}
+
+template<typename TGadget>
+template<typename TValue>
+void QColumnarGadgetListModel<TGadget>::bindColumn(int role, TValue TGadget::*member)
+{
+	const auto offset = role - Qt::UserRole - 1;
+	Q_ASSERT_X(offset >= 0 && offset < _storage.size(), Q_FUNC_INFO, "Cannot bind a column to a role without a property!");
+
+	// move the existing values over into the typed column
+	QSharedPointer<MemberColumn<TValue>> typedColumn{new MemberColumn<TValue>{member}};
+	typedColumn->values.reserve(_rowCount);
+	const auto &oldColumn = _storage[offset];
+	for(auto row = 0; row < _rowCount; ++row)
+		typedColumn->values.append(oldColumn->read(row).template value<TValue>());
+	_storage[offset] = typedColumn;
+
+	// a rebound column must no longer be found via its previous member
+	for(auto it = _memberColumns.begin(); it != _memberColumns.end();) {
+		if(*it == offset)
+			it = _memberColumns.erase(it);
+		else
+			++it;
+	}
+	_memberColumns.insert(memberKey(member), offset);
+}
+
+template<typename TGadget>
+template<typename TValue>
+inline void QColumnarGadgetListModel<TGadget>::bindColumn(const char *roleName, TValue TGadget::*member)
+{
+	bindColumn(roleNames().key(roleName), member);
+}
+
+template<typename TGadget>
+template<typename TValue>
+const QVector<TValue> &QColumnarGadgetListModel<TGadget>::column(TValue TGadget::*member) const
+{
+	const auto offset = columnIndex(member);
+	Q_ASSERT_X(offset != -1, Q_FUNC_INFO, "The member has not been bound to a column via bindColumn!");
+	return static_cast<const MemberColumn<TValue>*>(_storage[offset].data())->values;
+}
+
+template<typename TGadget>
+template<typename TValue>
+const TValue &QColumnarGadgetListModel<TGadget>::value(int row, TValue TGadget::*member) const
+{
+	return column(member)[row];
+}
+
+template<typename TGadget>
+template<typename TValue>
+void QColumnarGadgetListModel<TGadget>::setValue(int row, TValue TGadget::*member, TValue value)
+{
+	const auto offset = columnIndex(member);
+	Q_ASSERT_X(offset != -1, Q_FUNC_INFO, "The member has not been bound to a column via bindColumn!");
+	static_cast<MemberColumn<TValue>*>(_storage[offset].data())->values[row] = std::move(value);
+	emitDataChanged(index(row, 0), index(row, 0), {Qt::UserRole + 1 + offset});
+}
+
+template<typename TGadget>
+template<typename TValue, typename TLessThan>
+void QColumnarGadgetListModel<TGadget>::sortBy(TValue TGadget::*member, Qt::SortOrder order, TLessThan lessThan)
+{
+	const auto &values = column(member);
+	QVector<int> rowOrder(_rowCount);
+	std::iota(rowOrder.begin(), rowOrder.end(), 0);
+	std::stable_sort(rowOrder.begin(), rowOrder.end(), [&](int lhs, int rhs) {
+		return order == Qt::AscendingOrder ?
+					lessThan(values[lhs], values[rhs]) :
+					lessThan(values[rhs], values[lhs]);
+	});
+	permuteRows(rowOrder);
+}
+
+template<typename TGadget>
+int QColumnarGadgetListModel<TGadget>::rowCount(const QModelIndex &parent) const
+{
+	Q_ASSERT(this->checkIndex(parent, QAbstractItemModel::CheckIndexOption::DoNotUseParent));
+	if (parent.isValid())
+		return 0;
+	else
+		return _rowCount;
+}
+
+template<typename TGadget>
+QVariant QColumnarGadgetListModel<TGadget>::readProperty(int row, const QMetaProperty &property) const
+{
+	return _storage[property.propertyIndex()]->read(row);
+}
+
+template<typename TGadget>
+bool QColumnarGadgetListModel<TGadget>::writeProperty(int row, const QMetaProperty &property, const QVariant &data)
+{
+	return _storage[property.propertyIndex()]->write(row, data);
+}
+
+template<typename TGadget>
+bool QColumnarGadgetListModel<TGadget>::concurrentReads() const
+{
+	return true;
+}
+
+template<typename TGadget>
+template<typename TValue>
+typename QColumnarGadgetListModel<TGadget>::MemberKey QColumnarGadgetListModel<TGadget>::memberKey(TValue TGadget::*member)
+{
+	// member pointers cannot be hashed, but their bits identify the member for a given member type
+	static_assert(sizeof(member) <= sizeof(qint64), "Member pointers of TGadget are too large to be used as column keys");
+	static const char typeTag = 0;
+	qint64 bits = 0;
+	std::memcpy(&bits, &member, sizeof(member));
+	return {&typeTag, bits};
+}
+
+template<typename TGadget>
+template<typename TValue>
+int QColumnarGadgetListModel<TGadget>::columnIndex(TValue TGadget::*member) const
+{
+	// only filled by bindColumn, so the found column is always a MemberColumn<TValue>
+	return _memberColumns.value(memberKey(member), -1);
+}
+
+template<typename TGadget>
+void QColumnarGadgetListModel<TGadget>::permuteRows(const QVector<int> &order)
+{
+	emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+	for(const auto &column : qAsConst(_storage))
+		column->permute(order);
+
+	QVector<int> newRows(order.size());
+	for(auto i = 0; i < order.size(); ++i)
+		newRows[order[i]] = i;
+	const auto oldIndexes = persistentIndexList();
+	QModelIndexList newIndexes;
+	newIndexes.reserve(oldIndexes.size());
+	for(const auto &oldIndex : oldIndexes)
+		newIndexes.append(index(newRows[oldIndex.row()], oldIndex.column()));
+	changePersistentIndexList(oldIndexes, newIndexes);
+	emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+#endif // QCOLUMNARGADGETLISTMODEL_H
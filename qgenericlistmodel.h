@@ -1,8 +1,17 @@
 #ifndef QGENERICLISTMODEL_H
 #define QGENERICLISTMODEL_H
 
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <limits>
 #include <type_traits>
+#include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 #include "qmetaobjectmodel.h"
+#include "qmodelingestqueue.h"
 #include "qobjectlistmodel.h"
 
 template <typename TData, typename = void>
@@ -15,6 +24,8 @@ template <typename TObject>
 class QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>> : public QObjectListModel
 {
 public:
+	using RecycleFunc = std::function<void(TObject*)>;
+
 	explicit QGenericListModel(QObject *parent = nullptr);
 	explicit QGenericListModel(bool objectOwner, QObject *parent = nullptr);
 
@@ -29,51 +40,206 @@ public:
 	void addObject(TObject *object);
 	void insertObject(const QModelIndex &index, TObject *object);
 	void insertObject(int index, TObject *object);
+	void addObjects(const QList<TObject*> &objects);
+	void insertObjects(int index, const QList<TObject*> &objects);
 	void resetModel(const QList<TObject*> &objects);
+	void syncModel(const QList<TObject*> &objects);
+
+	int poolLimit() const;
+	void setPoolLimit(int limit);
+	void setRecycleHook(const RecycleFunc &hook);
+	int pooledObjects() const;
+	TObject *acquireObject();
+
+	void queueAddObject(TObject *object);
+	void queueInsertObject(int index, TObject *object);
+	void queueRemoveObject(int index);
+	int ingestBudget() const;
+	void setIngestBudget(int msecs);
+	void flushQueuedObjects();
+
+protected:
+	void releaseObject(QObject *object) override;
+	QObject *createObject() override;
+
+private:
+	QModelIngestQueue<TObject*> _ingestQueue;
+	QVector<TObject*> _pool;
+	int _poolLimit = 0;
+	RecycleFunc _recycleHook;
+
+	QObject *createObject(std::true_type defaultConstructible);
+	QObject *createObject(std::false_type defaultConstructible);
+	void applyQueued(typename QModelIngestQueue<TObject*>::Operation &operation);
+	template <typename TContainer>
+	static QObjectList toObjectList(const TContainer &objects);
 };
 
 template <typename TGadget>
 class QGenericListModel<TGadget, typename TGadget::QtGadgetHelper> : public QMetaObjectModel
 {
 public:
+	// an immutable, implicitly shared copy of all gadgets that may be read from any thread
+	struct Snapshot {
+		QVector<TGadget> gadgets;
+		quint64 revision = 0;
+	};
+	// changes against a snapshot, rows refer to the snapshot
+	struct Delta {
+		quint64 revision = 0;
+		QMap<int, TGadget> changed;
+		QVector<int> removed;
+		QVector<TGadget> added;
+	};
+
 	explicit QGenericListModel(QObject *parent = nullptr);
 
 	QList<TGadget> gadgets() const;
 	TGadget gadget(const QModelIndex &index) const;
 	TGadget gadget(int index) const;
 	void addGadget(const TGadget &gadget);
+	void addGadget(TGadget &&gadget);
+	template <typename... TArgs>
+	void emplaceGadget(TArgs&&... args);
 	void insertGadget(const QModelIndex &index, const TGadget &gadget);
 	void insertGadget(int index, const TGadget &gadget);
+	void insertGadget(int index, TGadget &&gadget);
 	void removeGadget(const QModelIndex &index);
 	void removeGadget(int index);
+	void addGadgets(const QList<TGadget> &gadgets);
+	void addGadgets(QVector<TGadget> gadgets);
+	void addGadgets(std::initializer_list<TGadget> gadgets);
+	void insertGadgets(int index, const QList<TGadget> &gadgets);
+	void insertGadgets(int index, QVector<TGadget> gadgets);
+	void insertGadgets(int index, std::initializer_list<TGadget> gadgets);
+	void removeGadgets(int first, int count);
+	bool moveGadget(int from, int to);
+	bool moveGadgets(int first, int count, int to);
 	TGadget takeGadget(const QModelIndex &index);
 	TGadget takeGadget(int index);
 	TGadget replaceGadget(const QModelIndex &index, const TGadget &gadget);
 	TGadget replaceGadget(int index, const TGadget &gadget);
-	void resetModel(QList<TGadget> gadgets);
+	TGadget replaceGadget(int index, TGadget &&gadget);
+	template <typename TModifier>
+	bool modifyGadget(int index, TModifier &&modifier);
+	void resetModel(const QList<TGadget> &gadgets);
+	void resetModel(QVector<TGadget> gadgets);
+	void resetModel(std::initializer_list<TGadget> gadgets);
+	void syncModel(const QList<TGadget> &gadgets);
+
+	int capacity() const;
+	void reserve(int size);
+	void shrinkToFit();
 
 	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	bool moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild) override;
 	using QMetaObjectModel::index;
 	QModelIndex index(const TGadget &gadget) const;
 
+	QByteArray keyProperty() const;
+	void setKeyProperty(const QByteArray &name);
+	int indexOfKey(const QVariant &key) const;
+	TGadget gadgetByKey(const QVariant &key) const;
+	bool replaceGadgetByKey(const TGadget &gadget);
+	bool removeGadgetByKey(const QVariant &key);
+
+	template <typename TValue>
+	void bindMember(int role, TValue TGadget::*member);
+	template <typename TValue>
+	inline void bindMember(const char *roleName, TValue TGadget::*member);
+	template <typename TValue, TValue TGadget::*Member>
+	void bindMember(int role);
+	template <typename TValue, TValue TGadget::*Member>
+	inline void bindMember(const char *roleName);
+	template <typename TGetter>
+	void bindGetter(int role, TGetter getter);
+	template <typename TGetter>
+	inline void bindGetter(const char *roleName, TGetter getter);
+
+	template <typename TValue>
+	const TValue &value(int row, TValue TGadget::*member) const;
+	template <typename TValue>
+	void setValue(int row, TValue TGadget::*member, TValue value);
+
+	void queueAddGadget(TGadget gadget);
+	void queueInsertGadget(int index, TGadget gadget);
+	void queueReplaceGadget(int index, TGadget gadget);
+	void queueRemoveGadget(int index);
+	int ingestBudget() const;
+	void setIngestBudget(int msecs);
+	void flushQueuedGadgets();
+
+	Snapshot snapshot() const;
+	bool applyDelta(const Delta &delta);
+
+	bool save(QIODevice *device) const;
+	bool save(const QString &fileName) const;
+	bool load(QIODevice *device);
+	bool load(const QString &fileName);
+
 protected:
 	QVariant readProperty(int row, const QMetaProperty &property) const override;
 	bool writeProperty(int row, const QMetaProperty &property, const QVariant &data) override;
+	bool concurrentReads() const override;
 
 private:
-	QList<TGadget> _gadgets;
+	struct Accessor {
+		// members bound as template arguments are called directly, without the std::function indirection
+		QVariant (*staticRead)(const TGadget&) = nullptr;
+		bool (*staticWrite)(TGadget&, const QVariant&) = nullptr;
+		std::function<QVariant(const TGadget&)> read;
+		std::function<bool(TGadget&, const QVariant&)> write;
+		std::function<const void*(const TGadget&)> address;
+	};
+
+	QVector<TGadget> _gadgets;
+	QVector<Accessor> _accessors; // index: role - Qt::UserRole - 1
+	QModelIngestQueue<TGadget> _ingestQueue;
+	quint64 _revision = 0; // bumped by every modification, identifies the state a snapshot was taken of
+	const QMetaProperty *_keyProperty = nullptr;
+	mutable QHash<QString, int> _keyRows;
+	mutable int _keyedRows = 0;
+
+	enum : quint32 {
+		SerializationMagic = 0x51474c4d, // "QGLM"
+		SerializationVersion = 1
+	};
+
+	Accessor &accessor(int role);
+	template <typename TValue, TValue TGadget::*Member>
+	static QVariant readMember(const TGadget &gadget);
+	template <typename TValue, TValue TGadget::*Member>
+	static bool writeMember(TGadget &gadget, const QVariant &data);
+	QVector<QMetaProperty> serializedProperties() const;
+	void applyQueued(typename QModelIngestQueue<TGadget>::Operation &operation);
+
+	QVariant readGadget(const TGadget &gadget, const QMetaProperty &property) const;
+	QString keyOf(const TGadget &gadget) const;
+	int rowOfKey(const QString &key) const;
+	void invalidateKeys(int fromRow);
+	void updateKey(int row);
+	QVector<int> changedRoles(const TGadget &oldGadget, const TGadget &newGadget) const;
 };
 
 // ------------- Generic Implementation
 
 template <typename TObject>
 QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::QGenericListModel(QObject *parent) :
-	QObjectListModel{&TObject::staticMetaObject, true, parent}
+	QGenericListModel{true, parent}
 {}
 
 template <typename TObject>
 QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::QGenericListModel(bool objectOwner, QObject *parent) :
-	QObjectListModel{&TObject::staticMetaObject, objectOwner, parent}
+	QObjectListModel{&TObject::staticMetaObject, objectOwner, parent},
+	_ingestQueue{this, [this](QVector<TObject*> objects) {
+		this->QObjectListModel::addObjects(toObjectList(objects));
+	}, [this](typename QModelIngestQueue<TObject*>::Operation &operation) {
+		applyQueued(operation);
+	}, [this](TObject *&object) {
+		// pending objects would have been adopted by the model
+		if(isObjectOwner())
+			delete object;
+	}}
 {}
 
 template <typename TObject>
@@ -142,27 +308,201 @@ void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::inse
 	this->QObjectListModel::insertObject(index, object);
 }
 
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::addObjects(const QList<TObject*> &objects)
+{
+	this->QObjectListModel::addObjects(toObjectList(objects));
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::insertObjects(int index, const QList<TObject*> &objects)
+{
+	this->QObjectListModel::insertObjects(index, toObjectList(objects));
+}
+
 template <typename TObject>
 void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::resetModel(const QList<TObject*> &objects)
+{
+	this->QObjectListModel::resetModel(toObjectList(objects));
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::syncModel(const QList<TObject*> &objects)
+{
+	this->QObjectListModel::syncModel(toObjectList(objects));
+}
+
+template <typename TObject>
+int QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::poolLimit() const
+{
+	return _poolLimit;
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::setPoolLimit(int limit)
+{
+	Q_ASSERT_X(limit >= 0, Q_FUNC_INFO, "The pool limit cannot be negative");
+	_poolLimit = limit;
+	while(_pool.size() > _poolLimit)
+		_pool.takeLast()->deleteLater();
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::setRecycleHook(const RecycleFunc &hook)
+{
+	_recycleHook = hook;
+}
+
+template <typename TObject>
+int QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::pooledObjects() const
+{
+	return _pool.size();
+}
+
+template <typename TObject>
+TObject *QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::acquireObject()
+{
+	// recycled objects are still parented to the model, so adding them again does not reparent them
+	if(_pool.isEmpty())
+		return new TObject{};
+	else
+		return _pool.takeLast();
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::releaseObject(QObject *object)
+{
+	auto obj = qobject_cast<TObject*>(object);
+	if(!obj || _pool.size() >= _poolLimit) {
+		this->QObjectListModel::releaseObject(object);
+		return;
+	}
+
+	if(_recycleHook)
+		_recycleHook(obj);
+	_pool.append(obj);
+}
+
+template <typename TObject>
+QObject *QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::createObject()
+{
+	return createObject(std::is_default_constructible<TObject>{});
+}
+
+template <typename TObject>
+QObject *QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::createObject(std::true_type)
+{
+	return acquireObject();
+}
+
+template <typename TObject>
+QObject *QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::createObject(std::false_type)
+{
+	// acquireObject cannot construct these, but recycled ones can still be reused
+	if(_pool.isEmpty())
+		return this->QObjectListModel::createObject();
+	else
+		return _pool.takeLast();
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::queueAddObject(TObject *object)
+{
+	// must happen on the producer thread, as only the owning thread may move an object
+	if(object->thread() != this->thread())
+		object->moveToThread(this->thread());
+	_ingestQueue.push(QModelIngestQueue<TObject*>::Operation::Append, -1, object);
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::queueInsertObject(int index, TObject *object)
+{
+	if(object->thread() != this->thread())
+		object->moveToThread(this->thread());
+	_ingestQueue.push(QModelIngestQueue<TObject*>::Operation::Insert, index, object);
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::queueRemoveObject(int index)
+{
+	_ingestQueue.push(QModelIngestQueue<TObject*>::Operation::Remove, index, nullptr);
+}
+
+template <typename TObject>
+int QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::ingestBudget() const
+{
+	return _ingestQueue.budget();
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::setIngestBudget(int msecs)
+{
+	_ingestQueue.setBudget(msecs);
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::flushQueuedObjects()
+{
+	_ingestQueue.drain(-1);
+}
+
+template <typename TObject>
+void QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::applyQueued(typename QModelIngestQueue<TObject*>::Operation &operation)
+{
+	// rows were chosen by the producer and may be outdated by now
+	const auto count = this->rowCount();
+	switch(operation.type) {
+	case QModelIngestQueue<TObject*>::Operation::Insert:
+		if(operation.row < 0 || operation.row > count) {
+			qWarning("QGenericListModel: queued insert at row %d is out of range, appending instead", operation.row);
+			operation.row = count;
+		}
+		insertObject(operation.row, operation.data);
+		break;
+	case QModelIngestQueue<TObject*>::Operation::Remove:
+		if(operation.row < 0 || operation.row >= count) {
+			qWarning("QGenericListModel: queued removal of row %d is out of range and was dropped", operation.row);
+			break;
+		}
+		removeObject(operation.row);
+		break;
+	default:
+		Q_UNREACHABLE();
+		break;
+	}
+}
+
+template <typename TObject>
+template <typename TContainer>
+QObjectList QGenericListModel<TObject, QGenericListModel_QObject_SFINAE<TObject>>::toObjectList(const TContainer &objects)
 {
 	QObjectList list;
 	list.reserve(objects.size());
 	for(auto obj : objects)
 		list.append(obj);
-	this->QObjectListModel::resetModel(std::move(list));
+	return list;
 }
 
 
 
 template<typename TGadget>
 QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::QGenericListModel(QObject *parent) :
-	QMetaObjectModel{&TGadget::staticMetaObject, parent}
-{}
+	QMetaObjectModel{&TGadget::staticMetaObject, parent},
+	_ingestQueue{this, [this](QVector<TGadget> gadgets) {
+		addGadgets(std::move(gadgets));
+	}, [this](typename QModelIngestQueue<TGadget>::Operation &operation) {
+		applyQueued(operation);
+	}}
+{
+	const auto keyIndex = TGadget::staticMetaObject.indexOfClassInfo("QObjectListModelKey");
+	if(keyIndex != -1)
+		setKeyProperty(TGadget::staticMetaObject.classInfo(keyIndex).value());
+}
 
 template<typename TGadget>
 QList<TGadget> QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::gadgets() const
 {
-	return _gadgets;
+	return _gadgets.toList();
 }
 
 template<typename TGadget>
@@ -180,12 +520,27 @@ TGadget QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::gadget(int
 
 template<typename TGadget>
 void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::addGadget(const TGadget &gadget)
+{
+	addGadget(TGadget{gadget});
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::addGadget(TGadget &&gadget)
 {
 	beginInsertRows(QModelIndex{}, _gadgets.size(), _gadgets.size());
-	_gadgets.append(gadget);
+	_gadgets.append(std::move(gadget));
+	++_revision;
 	endInsertRows();
 }
 
+template<typename TGadget>
+template<typename... TArgs>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::emplaceGadget(TArgs&&... args)
+{
+	// QVector cannot construct in place, so this constructs once and moves
+	addGadget(TGadget(std::forward<TArgs>(args)...));
+}
+
 template<typename TGadget>
 void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::insertGadget(const QModelIndex &index, const TGadget &gadget)
 {
@@ -199,8 +554,16 @@ void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::insertGadget(
 template<typename TGadget>
 void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::insertGadget(int index, const TGadget &gadget)
 {
-	beginInsertRows(QModelIndex{}, _gadgets.size(), _gadgets.size());
-	_gadgets.insert(index, gadget);
+	insertGadget(index, TGadget{gadget});
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::insertGadget(int index, TGadget &&gadget)
+{
+	beginInsertRows(QModelIndex{}, index, index);
+	_gadgets.insert(index, std::move(gadget));
+	++_revision;
+	invalidateKeys(index);
 	endInsertRows();
 }
 
@@ -216,9 +579,102 @@ void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::removeGadget(
 {
 	beginRemoveRows(QModelIndex{}, index, index);
 	_gadgets.removeAt(index);
+	++_revision;
+	invalidateKeys(index);
 	endRemoveRows();
 }
 
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::addGadgets(const QList<TGadget> &gadgets)
+{
+	insertGadgets(_gadgets.size(), gadgets);
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::addGadgets(QVector<TGadget> gadgets)
+{
+	insertGadgets(_gadgets.size(), std::move(gadgets));
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::addGadgets(std::initializer_list<TGadget> gadgets)
+{
+	insertGadgets(_gadgets.size(), QVector<TGadget>(gadgets));
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::insertGadgets(int index, const QList<TGadget> &gadgets)
+{
+	insertGadgets(index, gadgets.toVector());
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::insertGadgets(int index, std::initializer_list<TGadget> gadgets)
+{
+	insertGadgets(index, QVector<TGadget>(gadgets));
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::insertGadgets(int index, QVector<TGadget> gadgets)
+{
+	if(gadgets.isEmpty())
+		return;
+
+	beginInsertRows(QModelIndex{}, index, index + gadgets.size() - 1);
+	if(_gadgets.isEmpty())
+		_gadgets = std::move(gadgets);
+	else {
+		// append at the end, then rotate the new gadgets into place
+		const auto oldSize = _gadgets.size();
+		for(auto &gadget : gadgets)
+			_gadgets.append(std::move(gadget));
+		if(index < oldSize)
+			std::rotate(_gadgets.begin() + index, _gadgets.begin() + oldSize, _gadgets.end());
+	}
+	++_revision;
+	invalidateKeys(index);
+	endInsertRows();
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::removeGadgets(int first, int count)
+{
+	if(count <= 0)
+		return;
+
+	beginRemoveRows(QModelIndex{}, first, first + count - 1);
+	_gadgets.erase(_gadgets.begin() + first, _gadgets.begin() + first + count);
+	++_revision;
+	invalidateKeys(first);
+	endRemoveRows();
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::moveGadget(int from, int to)
+{
+	return moveGadgets(from, 1, to);
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::moveGadgets(int first, int count, int to)
+{
+	Q_ASSERT_X(first >= 0 && count >= 0 && first + count <= _gadgets.size(), Q_FUNC_INFO, "Invalid source range");
+	Q_ASSERT_X(to >= 0 && to + count <= _gadgets.size(), Q_FUNC_INFO, "Invalid target row");
+	if(count == 0 || first == to)
+		return false;
+
+	if(!beginMoveRows(QModelIndex{}, first, first + count - 1, QModelIndex{}, to > first ? to + count : to))
+		return false;
+	if(to > first)
+		std::rotate(_gadgets.begin() + first, _gadgets.begin() + first + count, _gadgets.begin() + to + count);
+	else
+		std::rotate(_gadgets.begin() + to, _gadgets.begin() + first, _gadgets.begin() + first + count);
+	++_revision;
+	invalidateKeys(std::min(first, to));
+	endMoveRows();
+	return true;
+}
+
 template<typename TGadget>
 TGadget QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::takeGadget(const QModelIndex &index)
 {
@@ -230,7 +686,9 @@ template<typename TGadget>
 TGadget QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::takeGadget(int index)
 {
 	beginRemoveRows(QModelIndex{}, index, index);
-	const auto gadget = _gadgets.takeAt(index);
+	auto gadget = _gadgets.takeAt(index);
+	++_revision;
+	invalidateKeys(index);
 	endRemoveRows();
 	return gadget;
 }
@@ -245,23 +703,126 @@ TGadget QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::replaceGad
 template<typename TGadget>
 TGadget QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::replaceGadget(int index, const TGadget &gadget)
 {
-	// remove old gadget
-	auto oldGad = _gadgets.at(index);
-	// add new object
-	_gadgets[index] = gadget;
-	emitDataChanged(this->index(index, 0), this->index(index, 0), {});
-	// return old object
+	return replaceGadget(index, TGadget{gadget});
+}
+
+template<typename TGadget>
+TGadget QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::replaceGadget(int index, TGadget &&gadget)
+{
+	// only report the roles that actually changed
+	const auto roles = changedRoles(_gadgets.at(index), gadget);
+	auto oldGad = std::move(_gadgets[index]);
+	_gadgets[index] = std::move(gadget);
+	++_revision;
+	updateKey(index);
+	if(!roles.isEmpty())
+		emitDataChanged(this->index(index, 0), this->index(index, 0), roles);
 	return oldGad;
 }
 
 template<typename TGadget>
-void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::resetModel(QList<TGadget> gadgets)
+template<typename TModifier>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::modifyGadget(int index, TModifier &&modifier)
+{
+	// remember the property values instead of copying the whole gadget
+	const auto &properties = this->roleProperties();
+	QVarLengthArray<QVariant, 32> oldValues;
+	oldValues.reserve(properties.size());
+	auto &gadget = _gadgets[index];
+	for(const auto &property : properties)
+		oldValues.append(readGadget(gadget, property));
+
+	std::forward<TModifier>(modifier)(gadget);
+	++_revision;
+	updateKey(index);
+
+	QVector<int> roles;
+	for(auto i = 0; i < properties.size(); ++i) {
+		if(readGadget(gadget, properties[i]) != oldValues[i])
+			roles.append(Qt::UserRole + 1 + i);
+	}
+	if(roles.isEmpty())
+		return false;
+	emitDataChanged(this->index(index, 0), this->index(index, 0), roles);
+	return true;
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::resetModel(const QList<TGadget> &gadgets)
+{
+	resetModel(gadgets.toVector());
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::resetModel(QVector<TGadget> gadgets)
 {
 	beginResetModel();
 	_gadgets = std::move(gadgets);
+	++_revision;
+	_keyRows.clear();
+	_keyedRows = 0;
 	endResetModel();
 }
 
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::resetModel(std::initializer_list<TGadget> gadgets)
+{
+	resetModel(QVector<TGadget>(gadgets));
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::syncModel(const QList<TGadget> &gadgets)
+{
+	const auto oldSize = _gadgets.size();
+	const auto newSize = gadgets.size();
+	const auto minSize = std::min(oldSize, newSize);
+
+	// skip unchanged rows at the beginning and the end
+	auto prefix = 0;
+	while(prefix < minSize && changedRoles(_gadgets[prefix], gadgets[prefix]).isEmpty())
+		++prefix;
+	auto suffix = 0;
+	while(suffix < minSize - prefix &&
+		  changedRoles(_gadgets[oldSize - suffix - 1], gadgets[newSize - suffix - 1]).isEmpty())
+		++suffix;
+
+	// update the overlapping rows in place, then insert or remove the rest
+	const auto oldCount = oldSize - prefix - suffix;
+	const auto newCount = newSize - prefix - suffix;
+	const auto common = std::min(oldCount, newCount);
+	for(auto row = prefix; row < prefix + common; ++row) {
+		const auto roles = changedRoles(_gadgets[row], gadgets[row]);
+		if(!roles.isEmpty()) {
+			_gadgets[row] = gadgets[row];
+			++_revision;
+			updateKey(row);
+			emitDataChanged(this->index(row, 0), this->index(row, 0), roles);
+		}
+	}
+	if(newCount > oldCount)
+		insertGadgets(prefix + common, gadgets.mid(prefix + common, newCount - oldCount));
+	else if(oldCount > newCount)
+		removeGadgets(prefix + common, oldCount - newCount);
+}
+
+template<typename TGadget>
+int QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::capacity() const
+{
+	return _gadgets.capacity();
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::reserve(int size)
+{
+	_gadgets.reserve(size);
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::shrinkToFit()
+{
+	_gadgets.squeeze();
+}
+
 template<typename TGadget>
 int QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::rowCount(const QModelIndex &parent) const
 {
@@ -272,26 +833,575 @@ int QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::rowCount(const
 		return _gadgets.size();
 }
 
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild)
+{
+	if(sourceParent.isValid() ||
+	   destinationParent.isValid() ||
+	   count <= 0 ||
+	   sourceRow < 0 ||
+	   sourceRow + count > _gadgets.size() ||
+	   destinationChild < 0 ||
+	   destinationChild > _gadgets.size() ||
+	   (destinationChild >= sourceRow && destinationChild <= sourceRow + count))
+		return false;
+	// destinationChild is the row to insert before, counted before the move
+	return moveGadgets(sourceRow, count, destinationChild > sourceRow ? destinationChild - count : destinationChild);
+}
+
 template<typename TGadget>
 QModelIndex QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::index(const TGadget &gadget) const
 {
-	auto row = _gadgets.indexOf(gadget);
+	// with a key property, gadgets are identified by their key instead of by comparing all values
+	const auto row = _keyProperty ? rowOfKey(keyOf(gadget)) : _gadgets.indexOf(gadget);
 	if(row != -1)
 		return index(row, 0);
 	else
 		return {};
 }
 
+template<typename TGadget>
+QByteArray QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::keyProperty() const
+{
+	return _keyProperty ? QByteArray{_keyProperty->name()} : QByteArray{};
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::setKeyProperty(const QByteArray &name)
+{
+	_keyProperty = propertyForRole(Qt::UserRole + 1 + TGadget::staticMetaObject.indexOfProperty(name.constData()));
+	Q_ASSERT_X(_keyProperty || name.isEmpty(), Q_FUNC_INFO, "The key must be a property of the gadget type");
+	_keyRows.clear();
+	_keyedRows = 0;
+}
+
+template<typename TGadget>
+int QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::indexOfKey(const QVariant &key) const
+{
+	Q_ASSERT_X(_keyProperty, Q_FUNC_INFO, "No key property has been set");
+	return rowOfKey(key.toString());
+}
+
+template<typename TGadget>
+TGadget QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::gadgetByKey(const QVariant &key) const
+{
+	const auto row = indexOfKey(key);
+	return row != -1 ? _gadgets[row] : TGadget{};
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::replaceGadgetByKey(const TGadget &gadget)
+{
+	Q_ASSERT_X(_keyProperty, Q_FUNC_INFO, "No key property has been set");
+	const auto row = rowOfKey(keyOf(gadget));
+	if(row == -1)
+		return false;
+	replaceGadget(row, gadget);
+	return true;
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::removeGadgetByKey(const QVariant &key)
+{
+	const auto row = indexOfKey(key);
+	if(row == -1)
+		return false;
+	removeGadget(row);
+	return true;
+}
+
+template<typename TGadget>
+template<typename TValue>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::bindMember(int role, TValue TGadget::*member)
+{
+	auto &acc = accessor(role);
+	acc.staticRead = nullptr;
+	acc.staticWrite = nullptr;
+	acc.read = [member](const TGadget &gadget) {
+		return QVariant::fromValue(gadget.*member);
+	};
+	acc.write = [member](TGadget &gadget, const QVariant &data) {
+		if(!data.canConvert<TValue>())
+			return false;
+		gadget.*member = data.value<TValue>();
+		return true;
+	};
+	acc.address = [member](const TGadget &gadget) -> const void* {
+		return &(gadget.*member);
+	};
+}
+
+template<typename TGadget>
+template<typename TValue>
+inline void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::bindMember(const char *roleName, TValue TGadget::*member)
+{
+	bindMember(this->roleNames().key(roleName), member);
+}
+
+template<typename TGadget>
+template<typename TValue, TValue TGadget::*Member>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::bindMember(int role)
+{
+	auto &acc = accessor(role);
+	acc.staticRead = &readMember<TValue, Member>;
+	acc.staticWrite = &writeMember<TValue, Member>;
+	// the std::functions are kept for the code paths that are not performance critical
+	acc.read = acc.staticRead;
+	acc.write = acc.staticWrite;
+	acc.address = [](const TGadget &gadget) -> const void* {
+		return &(gadget.*Member);
+	};
+}
+
+template<typename TGadget>
+template<typename TValue, TValue TGadget::*Member>
+inline void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::bindMember(const char *roleName)
+{
+	bindMember<TValue, Member>(this->roleNames().key(roleName));
+}
+
+template<typename TGadget>
+template<typename TGetter>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::bindGetter(int role, TGetter getter)
+{
+	auto &acc = accessor(role);
+	acc.staticRead = nullptr;
+	acc.staticWrite = nullptr;
+	acc.read = [getter](const TGadget &gadget) {
+		return QVariant::fromValue(getter(gadget));
+	};
+	acc.write = {};
+	acc.address = {};
+}
+
+template<typename TGadget>
+template<typename TGetter>
+inline void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::bindGetter(const char *roleName, TGetter getter)
+{
+	bindGetter(this->roleNames().key(roleName), std::move(getter));
+}
+
+template<typename TGadget>
+template<typename TValue>
+const TValue &QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::value(int row, TValue TGadget::*member) const
+{
+	return _gadgets[row].*member;
+}
+
+template<typename TGadget>
+template<typename TValue>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::setValue(int row, TValue TGadget::*member, TValue value)
+{
+	auto &gadget = _gadgets[row];
+	gadget.*member = std::move(value);
+	++_revision;
+	updateKey(row);
+
+	// find the role bound to the member by comparing member addresses
+	const void *address = &(gadget.*member);
+	QVector<int> roles;
+	for(auto i = 0; i < _accessors.size(); ++i) {
+		const auto &acc = _accessors[i];
+		if(acc.address && acc.address(gadget) == address) {
+			roles.append(Qt::UserRole + 1 + i);
+			break;
+		}
+	}
+	emitDataChanged(this->index(row, 0), this->index(row, 0), roles);
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::queueAddGadget(TGadget gadget)
+{
+	_ingestQueue.push(QModelIngestQueue<TGadget>::Operation::Append, -1, std::move(gadget));
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::queueInsertGadget(int index, TGadget gadget)
+{
+	_ingestQueue.push(QModelIngestQueue<TGadget>::Operation::Insert, index, std::move(gadget));
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::queueReplaceGadget(int index, TGadget gadget)
+{
+	_ingestQueue.push(QModelIngestQueue<TGadget>::Operation::Replace, index, std::move(gadget));
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::queueRemoveGadget(int index)
+{
+	_ingestQueue.push(QModelIngestQueue<TGadget>::Operation::Remove, index, {});
+}
+
+template<typename TGadget>
+int QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::ingestBudget() const
+{
+	return _ingestQueue.budget();
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::setIngestBudget(int msecs)
+{
+	_ingestQueue.setBudget(msecs);
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::flushQueuedGadgets()
+{
+	_ingestQueue.drain(-1);
+}
+
+template<typename TGadget>
+typename QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::Snapshot QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::snapshot() const
+{
+	// the model does not keep the snapshot, so modifications only copy the list while a snapshot is still in use
+	return Snapshot{_gadgets, _revision};
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::applyDelta(const Delta &delta)
+{
+	// the model was modified after the snapshot was taken -> rows may no longer match
+	if(delta.revision != _revision)
+		return false;
+	// rows are validated up front, so an invalid delta is not applied partially
+	if(!delta.changed.isEmpty() &&
+	   (delta.changed.firstKey() < 0 || delta.changed.lastKey() >= _gadgets.size()))
+		return false;
+	for(auto row : delta.removed) {
+		if(row < 0 || row >= _gadgets.size())
+			return false;
+	}
+
+	for(auto it = delta.changed.constBegin(); it != delta.changed.constEnd(); ++it) {
+		const auto roles = changedRoles(_gadgets.at(it.key()), *it);
+		if(roles.isEmpty())
+			continue;
+		_gadgets[it.key()] = *it;
+		++_revision;
+		updateKey(it.key());
+		emitDataChanged(index(it.key(), 0), index(it.key(), 0), roles);
+	}
+
+	// remove from the back in contiguous ranges, so the snapshot rows stay valid
+	auto removed = delta.removed;
+	std::sort(removed.begin(), removed.end(), std::greater<int>{});
+	removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+	for(auto i = 0; i < removed.size();) {
+		auto count = 1;
+		while(i + count < removed.size() && removed[i + count] == removed[i] - count)
+			++count;
+		removeGadgets(removed[i + count - 1], count);
+		i += count;
+	}
+
+	addGadgets(delta.added);
+	return true;
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::save(QIODevice *device) const
+{
+	if(!device || !device->isWritable())
+		return false;
+
+	// the header describes the property layout, so a changed gadget is detected when loading
+	const auto properties = serializedProperties();
+	QDataStream stream{device};
+	stream.setVersion(QDataStream::Qt_5_11);
+	stream << static_cast<quint32>(SerializationMagic)
+		   << static_cast<quint32>(SerializationVersion)
+		   << QByteArray{TGadget::staticMetaObject.className()}
+		   << static_cast<qint32>(properties.size());
+	for(const auto &property : properties)
+		stream << QByteArray{property.name()} << QByteArray{QMetaType::typeName(property.userType())};
+
+	stream << static_cast<qint32>(_gadgets.size());
+	for(auto row = 0; row < _gadgets.size(); ++row) {
+		for(const auto &property : properties) {
+			auto value = readProperty(row, property);
+			if(value.userType() != property.userType())
+				value.convert(property.userType());
+			if(!QMetaType::save(stream, property.userType(), value.constData()))
+				return false;
+		}
+	}
+	return stream.status() == QDataStream::Ok;
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::save(const QString &fileName) const
+{
+	QSaveFile file{fileName};
+	if(!file.open(QIODevice::WriteOnly))
+		return false;
+	if(!save(&file)) {
+		file.cancelWriting();
+		return false;
+	}
+	return file.commit();
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::load(QIODevice *device)
+{
+	if(!device || !device->isReadable())
+		return false;
+
+	QDataStream stream{device};
+	stream.setVersion(QDataStream::Qt_5_11);
+	quint32 magic = 0;
+	quint32 version = 0;
+	QByteArray className;
+	qint32 propertyCount = 0;
+	stream >> magic >> version >> className >> propertyCount;
+	const auto properties = serializedProperties();
+	if(stream.status() != QDataStream::Ok ||
+	   magic != SerializationMagic ||
+	   version != SerializationVersion ||
+	   className != TGadget::staticMetaObject.className() ||
+	   propertyCount != properties.size())
+		return false;
+	for(const auto &property : properties) {
+		QByteArray name;
+		QByteArray typeName;
+		stream >> name >> typeName;
+		if(name != property.name() ||
+		   typeName != QMetaType::typeName(property.userType()))
+			return false;
+	}
+
+	qint32 rows = 0;
+	stream >> rows;
+	if(stream.status() != QDataStream::Ok || rows < 0)
+		return false;
+
+	// one preallocated value per property, that is reused for every row
+	QVector<QVariant> values;
+	values.reserve(properties.size());
+	for(const auto &property : properties)
+		values.append(QVariant{property.userType(), nullptr});
+
+	// every row takes at least one byte per property, so a corrupted count fails before anything is allocated
+	const auto checkable = !properties.isEmpty() && !device->isSequential();
+	if(checkable && rows > device->bytesAvailable() / properties.size())
+		return false;
+	// otherwise only a limited amount is reserved, the rest grows while reading
+	const qint32 maxUncheckedRows = 65536;
+	QVector<TGadget> gadgets;
+	gadgets.reserve(checkable ? rows : std::min(rows, maxUncheckedRows));
+	for(auto row = 0; row < rows; ++row) {
+		TGadget gadget;
+		for(auto i = 0; i < properties.size(); ++i) {
+			const auto &property = properties[i];
+			if(!QMetaType::load(stream, property.userType(), values[i].data()))
+				return false;
+			const auto propIndex = property.propertyIndex();
+			if(propIndex < _accessors.size() && _accessors[propIndex].write)
+				_accessors[propIndex].write(gadget, values[i]);
+			else
+				property.writeOnGadget(&gadget, values[i]);
+		}
+		gadgets.append(std::move(gadget));
+	}
+	if(stream.status() != QDataStream::Ok)
+		return false;
+
+	resetModel(std::move(gadgets));
+	return true;
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::load(const QString &fileName)
+{
+	QFile file{fileName};
+	if(!file.open(QIODevice::ReadOnly))
+		return false;
+
+	// parse straight from the mapped file instead of reading it through the device
+	const auto size = file.size();
+	const auto data = size <= std::numeric_limits<int>::max() ? file.map(0, size) : nullptr;
+	if(!data)
+		return load(&file);
+
+	QBuffer buffer;
+	buffer.setData(QByteArray::fromRawData(reinterpret_cast<const char*>(data), static_cast<int>(size)));
+	buffer.open(QIODevice::ReadOnly);
+	const auto ok = load(&buffer);
+	buffer.close();
+	file.unmap(data);
+	return ok;
+}
+
 template<typename TGadget>
 QVariant QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::readProperty(int row, const QMetaProperty &property) const
 {
-	return property.readOnGadget(&(_gadgets[row]));
+	return readGadget(_gadgets[row], property);
 }
 
 template<typename TGadget>
 bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::writeProperty(int row, const QMetaProperty &property, const QVariant &data)
 {
-	return property.writeOnGadget(&(_gadgets[row]), data);
+	const auto propIndex = property.propertyIndex();
+	const auto acc = propIndex < _accessors.size() ? &_accessors[propIndex] : nullptr;
+	const auto ok = acc && acc->staticWrite ? acc->staticWrite(_gadgets[row], data) :
+					acc && acc->write ? acc->write(_gadgets[row], data) :
+					property.writeOnGadget(&(_gadgets[row]), data);
+	if(ok) {
+		++_revision;
+		updateKey(row);
+	}
+	return ok;
+}
+
+template<typename TGadget>
+QVector<QMetaProperty> QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::serializedProperties() const
+{
+	// only properties that can be restored are saved
+	QVector<QMetaProperty> properties;
+	for(const auto &property : roleProperties()) {
+		const auto propIndex = property.propertyIndex();
+		if(property.isWritable() ||
+		   (propIndex < _accessors.size() && _accessors[propIndex].write))
+			properties.append(property);
+	}
+	return properties;
+}
+
+template<typename TGadget>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::concurrentReads() const
+{
+	return true;
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::applyQueued(typename QModelIngestQueue<TGadget>::Operation &operation)
+{
+	// rows were chosen by the producer and may be outdated by now
+	const auto count = _gadgets.size();
+	switch(operation.type) {
+	case QModelIngestQueue<TGadget>::Operation::Insert:
+		if(operation.row < 0 || operation.row > count) {
+			qWarning("QGenericListModel: queued insert at row %d is out of range, appending instead", operation.row);
+			operation.row = count;
+		}
+		insertGadget(operation.row, std::move(operation.data));
+		break;
+	case QModelIngestQueue<TGadget>::Operation::Replace:
+		if(operation.row < 0 || operation.row >= count) {
+			qWarning("QGenericListModel: queued replacement of row %d is out of range and was dropped", operation.row);
+			break;
+		}
+		replaceGadget(operation.row, std::move(operation.data));
+		break;
+	case QModelIngestQueue<TGadget>::Operation::Remove:
+		if(operation.row < 0 || operation.row >= count) {
+			qWarning("QGenericListModel: queued removal of row %d is out of range and was dropped", operation.row);
+			break;
+		}
+		removeGadget(operation.row);
+		break;
+	default:
+		Q_UNREACHABLE();
+		break;
+	}
+}
+
+template<typename TGadget>
+QVariant QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::readGadget(const TGadget &gadget, const QMetaProperty &property) const
+{
+	const auto propIndex = property.propertyIndex();
+	if(propIndex < _accessors.size()) {
+		const auto &acc = _accessors[propIndex];
+		if(acc.staticRead)
+			return acc.staticRead(gadget);
+		if(acc.read)
+			return acc.read(gadget);
+	}
+	return property.readOnGadget(&gadget);
+}
+
+template<typename TGadget>
+QString QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::keyOf(const TGadget &gadget) const
+{
+	return readGadget(gadget, *_keyProperty).toString();
+}
+
+template<typename TGadget>
+int QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::rowOfKey(const QString &key) const
+{
+	// rows below _keyedRows are indexed, rows above are indexed lazily on lookup
+	const auto it = _keyRows.constFind(key);
+	if(it != _keyRows.constEnd()) {
+		if(*it < _keyedRows && keyOf(_gadgets[*it]) == key)
+			return *it;
+		_keyRows.remove(key);
+	}
+
+	while(_keyedRows < _gadgets.size()) {
+		const auto row = _keyedRows++;
+		const auto rowKey = keyOf(_gadgets[row]);
+		_keyRows.insert(rowKey, row);
+		if(rowKey == key)
+			return row;
+	}
+	return -1;
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::invalidateKeys(int fromRow)
+{
+	// rows were inserted, removed or moved -> all rows behind are shifted
+	_keyedRows = std::min(_keyedRows, fromRow);
+}
+
+template<typename TGadget>
+void QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::updateKey(int row)
+{
+	// the entry of the old key is dropped once it fails verification in rowOfKey
+	if(_keyProperty && row < _keyedRows)
+		_keyRows.insert(keyOf(_gadgets[row]), row);
+}
+
+template<typename TGadget>
+QVector<int> QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::changedRoles(const TGadget &oldGadget, const TGadget &newGadget) const
+{
+	QVector<int> roles;
+	auto role = Qt::UserRole + 1;
+	for(const auto &property : this->roleProperties()) {
+		if(readGadget(oldGadget, property) != readGadget(newGadget, property))
+			roles.append(role);
+		++role;
+	}
+	return roles;
+}
+
+template<typename TGadget>
+typename QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::Accessor &QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::accessor(int role)
+{
+	const auto offset = role - Qt::UserRole - 1;
+	Q_ASSERT_X(offset >= 0 && offset < this->roleProperties().size(), Q_FUNC_INFO, "Cannot bind an accessor to a role without a property!");
+	if(_accessors.size() <= offset)
+		_accessors.resize(this->roleProperties().size());
+	return _accessors[offset];
+}
+
+template<typename TGadget>
+template<typename TValue, TValue TGadget::*Member>
+QVariant QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::readMember(const TGadget &gadget)
+{
+	return QVariant::fromValue(gadget.*Member);
+}
+
+template<typename TGadget>
+template<typename TValue, TValue TGadget::*Member>
+bool QGenericListModel<TGadget, typename TGadget::QtGadgetHelper>::writeMember(TGadget &gadget, const QVariant &data)
+{
+	if(!data.canConvert<TValue>())
+		return false;
+	gadget.*Member = data.value<TValue>();
+	return true;
 }
 
 #endif // QGENERICLISTMODEL_H
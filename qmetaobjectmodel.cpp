@@ -1,15 +1,62 @@
 #include "qmetaobjectmodel.h"
+#include <algorithm>
+#include <functional>
+#include <QDataStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+namespace {
+
+const int ExportChunkSize = 4096;
+const int MinConcurrentRows = 256;
+
+class ReadTask : public QRunnable
+{
+public:
+	inline ReadTask(std::function<void()> read, QSemaphore *done) :
+		_read{std::move(read)},
+		_done{done}
+	{}
+
+	void run() override {
+		_read();
+		_done->release();
+	}
+
+private:
+	std::function<void()> _read;
+	QSemaphore *_done;
+};
+
+QByteArray csvField(const QVariant &value)
+{
+	auto field = value.toString().toUtf8();
+	if(field.contains(',') ||
+	   field.contains('"') ||
+	   field.contains('\n') ||
+	   field.contains('\r')) {
+		field.replace('"', "\"\"");
+		field.prepend('"');
+		field.append('"');
+	}
+	return field;
+}
+
+}
 
 QMetaObjectModel::QMetaObjectModel(const QMetaObject *metaType, QObject *parent) :
 	QModelAliasBaseAdapter(parent),
 	_metaObject{metaType}
 {
 	auto roleIndex = Qt::UserRole + 1;
+	_roleProperties.reserve(_metaObject->propertyCount());
 	for(auto i = 0; i < _metaObject->propertyCount(); i++) {
 		auto prop = _metaObject->property(i);
-		if(prop.hasNotifySignal())
-			registerSignalHelper(roleIndex, prop.notifySignal());
 		_roleNames.insert(roleIndex++, prop.name());
+		_roleProperties.append(prop);
 	}
 }
 
@@ -47,10 +94,9 @@ void QMetaObjectModel::setEditable(bool editable)
 	if (_editable == editable)
 		return;
 
-	beginResetModel();
 	_editable = editable;
 	emit editableChanged(_editable, {});
-	endResetModel();
+	emitFlagsChanged(0, columnCount() - 1);
 }
 
 QString QMetaObjectModel::defaultHeaderData() const
@@ -63,11 +109,11 @@ QVariant QMetaObjectModel::originalData(const QModelIndex &index, int role) cons
 	Q_ASSERT(checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid));
 	Q_ASSERT_X(index.column() == 0, Q_FUNC_INFO, "originalData must always be called only with an index for column 0");
 
-	const auto propIndex = _metaObject->indexOfProperty(roleNames().value(role).constData());
-	if(propIndex < 0)
+	const auto property = propertyForRole(role);
+	if(!property)
 		return {};
 	else
-		return readProperty(index.row(), _metaObject->property(propIndex));
+		return readProperty(index.row(), *property);
 }
 
 bool QMetaObjectModel::setOriginalData(const QModelIndex &index, const QVariant &value, int role)
@@ -78,18 +124,166 @@ bool QMetaObjectModel::setOriginalData(const QModelIndex &index, const QVariant
 	if(!_editable)
 		return false;
 
-	const auto propIndex = _metaObject->indexOfProperty(roleNames().value(role).constData());
-	if(propIndex < 0)
+	const auto property = propertyForRole(role);
+	if(!property)
 		return false;
-	else if(writeProperty(index.row(), _metaObject->property(propIndex), value)) {
+	else if(writeProperty(index.row(), *property, value)) {
 		emitDataChanged(index, index, {role});
 		return true;
 	} else
 		return false;
 }
 
-void QMetaObjectModel::registerSignalHelper(int role, const QMetaMethod &signal)
+bool QMetaObjectModel::exportModel(QIODevice *device, ExportFormat format, const QByteArrayList &roleNames) const
+{
+	if(!device || !device->isWritable())
+		return false;
+
+	// resolve the properties once instead of once per cell
+	QVector<QMetaProperty> properties;
+	if(roleNames.isEmpty())
+		properties = _roleProperties;
+	else {
+		properties.reserve(roleNames.size());
+		for(const auto &name : roleNames) {
+			const auto property = propertyForRole(_roleNames.key(name, -1));
+			if(!property)
+				return false;
+			properties.append(*property);
+		}
+	}
+
+	QByteArrayList names;
+	QStringList keys;
+	names.reserve(properties.size());
+	keys.reserve(properties.size());
+	for(const auto &property : qAsConst(properties)) {
+		names.append(property.name());
+		keys.append(QString::fromUtf8(property.name()));
+	}
+
+	const auto rows = rowCount();
+	QDataStream stream;
+	switch(format) {
+	case ExportFormat::Csv:
+		if(device->write(names.join(',') + "\r\n") == -1)
+			return false;
+		break;
+	case ExportFormat::Json:
+		if(device->write("[") == -1)
+			return false;
+		break;
+	case ExportFormat::DataStream:
+		stream.setDevice(device);
+		stream << static_cast<qint32>(rows) << names;
+		break;
+	}
+
+	// the buffer is column major: buffer[column * ExportChunkSize + row - first]
+	QVector<QVariant> buffer(ExportChunkSize * properties.size());
+	for(auto first = 0; first < rows; first += ExportChunkSize) {
+		const auto count = std::min(ExportChunkSize, rows - first);
+		readColumns(properties, first, count, buffer);
+
+		QByteArray chunk;
+		for(auto row = 0; row < count; ++row) {
+			switch(format) {
+			case ExportFormat::Csv:
+				for(auto column = 0; column < properties.size(); ++column) {
+					if(column > 0)
+						chunk.append(',');
+					chunk.append(csvField(buffer[column * ExportChunkSize + row]));
+				}
+				chunk.append("\r\n");
+				break;
+			case ExportFormat::Json:
+			{
+				QJsonObject object;
+				for(auto column = 0; column < properties.size(); ++column)
+					object.insert(keys[column], QJsonValue::fromVariant(buffer[column * ExportChunkSize + row]));
+				if(first + row > 0)
+					chunk.append(',');
+				chunk.append(QJsonDocument{object}.toJson(QJsonDocument::Compact));
+				break;
+			}
+			case ExportFormat::DataStream:
+				for(auto column = 0; column < properties.size(); ++column)
+					stream << buffer[column * ExportChunkSize + row];
+				break;
+			}
+		}
+
+		if(format == ExportFormat::DataStream) {
+			if(stream.status() != QDataStream::Ok)
+				return false;
+		} else if(device->write(chunk) != chunk.size())
+			return false;
+	}
+
+	switch(format) {
+	case ExportFormat::Csv:
+		return true;
+	case ExportFormat::Json:
+		return device->write("]") != -1;
+	case ExportFormat::DataStream:
+		return stream.status() == QDataStream::Ok;
+	}
+	return false;
+}
+
+const QMetaObject *QMetaObjectModel::metaType() const
+{
+	return _metaObject;
+}
+
+const QMetaProperty *QMetaObjectModel::propertyForRole(int role) const
+{
+	const auto offset = role - Qt::UserRole - 1;
+	if(offset < 0 || offset >= _roleProperties.size())
+		return nullptr;
+	else
+		return &_roleProperties[offset];
+}
+
+const QVector<QMetaProperty> &QMetaObjectModel::roleProperties() const
+{
+	return _roleProperties;
+}
+
+bool QMetaObjectModel::concurrentReads() const
+{
+	return false;
+}
+
+void QMetaObjectModel::readColumns(const QVector<QMetaProperty> &properties, int first, int count, QVector<QVariant> &buffer) const
 {
-	Q_UNUSED(role);
-	Q_UNUSED(signal);
+	// detach on this thread, the tasks only write to distinct elements
+	const auto data = buffer.data();
+	const auto readRange = [&](int from, int to) {
+		for(auto column = 0; column < properties.size(); ++column) {
+			const auto &property = properties[column];
+			const auto out = data + column * ExportChunkSize;
+			for(auto row = from; row < to; ++row)
+				out[row - first] = readProperty(row, property);
+		}
+	};
+
+	auto pool = QThreadPool::globalInstance();
+	const auto threads = concurrentReads() ? pool->maxThreadCount() : 1;
+	if(threads <= 1 || count < MinConcurrentRows) {
+		readRange(first, first + count);
+		return;
+	}
+
+	const auto end = first + count;
+	const auto slice = (count + threads - 1) / threads;
+	QSemaphore done;
+	auto tasks = 0;
+	for(auto from = first; from < end; from += slice, ++tasks) {
+		const auto to = std::min(from + slice, end);
+		pool->start(new ReadTask{[&readRange, from, to]() {
+			readRange(from, to);
+		}, &done});
+	}
+	done.acquire(tasks);
 }
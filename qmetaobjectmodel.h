@@ -1,7 +1,10 @@
 #ifndef QMETAOBJECTMODEL_H
 #define QMETAOBJECTMODEL_H
 
+#include <QtCore/QByteArrayList>
+#include <QtCore/QIODevice>
 #include <QtCore/QMetaProperty>
+#include <QtCore/QVector>
 
 #include "qmodelaliasadapter.h"
 
@@ -12,6 +15,13 @@ class Q_QOBJECT_LIST_MODEL_EXPORT QMetaObjectModel : public QModelAliasBaseAdapt
 	Q_PROPERTY(bool editable READ editable WRITE setEditable NOTIFY editableChanged)
 
 public:
+	enum class ExportFormat {
+		Csv,
+		Json,
+		DataStream
+	};
+	Q_ENUM(ExportFormat)
+
 	explicit QMetaObjectModel(const QMetaObject *metaType,
 							  QObject *parent = nullptr);
 
@@ -20,6 +30,8 @@ public:
 
 	bool editable() const;
 
+	bool exportModel(QIODevice *device, ExportFormat format, const QByteArrayList &roleNames = {}) const;
+
 public Q_SLOTS:
 	void setEditable(bool editable);
 
@@ -33,12 +45,20 @@ protected:
 
 	virtual QVariant readProperty(int row, const QMetaProperty &property) const = 0;
 	virtual bool writeProperty(int row, const QMetaProperty &property, const QVariant &data) = 0;
-	virtual void registerSignalHelper(int role, const QMetaMethod &signal);
+	// true if readProperty may be called from multiple threads at once, as long as the model is not modified
+	virtual bool concurrentReads() const;
+
+	const QMetaObject *metaType() const;
+	const QMetaProperty *propertyForRole(int role) const;
+	const QVector<QMetaProperty> &roleProperties() const;
 
 private:
 	const QMetaObject *_metaObject;
 	QHash<int, QByteArray> _roleNames;
+	QVector<QMetaProperty> _roleProperties; // index: role - Qt::UserRole - 1
 	bool _editable = false;
+
+	void readColumns(const QVector<QMetaProperty> &properties, int first, int count, QVector<QVariant> &buffer) const;
 };
 
 #endif // QMETAOBJECTMODEL_H
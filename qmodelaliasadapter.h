@@ -1,13 +1,37 @@
 #ifndef QMODELALIASADAPTER_H
 #define QMODELALIASADAPTER_H
 
+#include <algorithm>
+#include <functional>
 #include <type_traits>
 
 #include <QtCore/QAbstractItemModel>
 #include <QtCore/QAbstractTableModel>
 #include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QTimer>
+#include <QtCore/QVarLengthArray>
 #include <QtCore/QDebug>
 
+// deduces the source and target type of a unary converter from its call signature
+template <typename TFunc, typename = void>
+struct QModelAliasConverterTraits {};
+
+template <typename TResult, typename TArg>
+struct QModelAliasConverterTraits<TResult(*)(TArg)> {
+	using Source = typename std::decay<TArg>::type;
+	using Target = typename std::decay<TResult>::type;
+};
+
+template <typename TClass, typename TResult, typename TArg>
+struct QModelAliasConverterTraits<TResult(TClass::*)(TArg)> : QModelAliasConverterTraits<TResult(*)(TArg)> {};
+
+template <typename TClass, typename TResult, typename TArg>
+struct QModelAliasConverterTraits<TResult(TClass::*)(TArg) const> : QModelAliasConverterTraits<TResult(*)(TArg)> {};
+
+template <typename TFunc>
+struct QModelAliasConverterTraits<TFunc, decltype(void(&TFunc::operator()))> : QModelAliasConverterTraits<decltype(&TFunc::operator())> {};
+
 template <typename TModel = QAbstractTableModel>
 class QModelAliasBaseAdapter : public TModel
 {
@@ -19,7 +43,20 @@ public:
 		Write
 	};
 
+	enum class ColumnChangeMode {
+		WidenToLastColumn,
+		ContiguousRuns
+	};
+
+	enum class ChangeCoalescing {
+		Immediate,
+		EventLoop,
+		Timer,
+		Manual
+	};
+
 	using ConverterFunc = std::function<QVariant(Convert, QVariant)>;
+	using FlushObserverFunc = std::function<void(int firstRow, int lastRow, const QVector<int> &roles, int absorbed)>;
 
 	explicit QModelAliasBaseAdapter(QObject *parent = nullptr);
 
@@ -40,7 +77,11 @@ public:
 	inline void addRole(int column, int aliasRole, const char *originalRoleName);
 
 	void addSrcConverter(int originalRole, const ConverterFunc &converter);
+	template <typename TRead, typename TWrite = std::nullptr_t, typename TTraits = QModelAliasConverterTraits<typename std::decay<TRead>::type>, typename = typename TTraits::Source>
+	inline void addSrcConverter(int originalRole, TRead &&read, TWrite &&write = nullptr);
 	void addAliasConverter(int column, int aliasRole, const ConverterFunc &converter);
+	template <typename TRead, typename TWrite = std::nullptr_t, typename TTraits = QModelAliasConverterTraits<typename std::decay<TRead>::type>, typename = typename TTraits::Source>
+	inline void addAliasConverter(int column, int aliasRole, TRead &&read, TWrite &&write = nullptr);
 
 	void setExtraFlags(int column, Qt::ItemFlags addFlags, Qt::ItemFlags removeFlags = Qt::NoItemFlags);
 
@@ -48,6 +89,14 @@ public:
 	QString columnTitle(int column) const;
 	int resolveRole(int column, int aliasRole) const;
 
+	ColumnChangeMode columnChangeMode() const;
+	void setColumnChangeMode(ColumnChangeMode mode);
+
+	ChangeCoalescing changeCoalescing() const;
+	void setChangeCoalescing(ChangeCoalescing mode, int interval = 0);
+	void setFlushObserver(const FlushObserverFunc &observer);
+	void flushChanges();
+
 protected:
 	virtual QString defaultHeaderData() const;
 	virtual QVariant originalData(const QModelIndex &index, int role) const = 0;
@@ -55,17 +104,22 @@ protected:
 
 	void applyExtraFlags(int column, Qt::ItemFlags &flags) const;
 	void emitDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles = QVector<int>());
+	void emitFlagsChanged(int firstColumn, int lastColumn);
 
 	// dummy to make private
 	inline void dataChanged(const QModelIndex &, const QModelIndex &, const QVector<int> &){}
 
 private:
-	using RoleMapping = QHash<int, int>;
+	struct AliasRole {
+		int originalRole = -1;
+		int converter = -1; // slot in ColumnInfo::converters
+	};
+	using RoleMapping = QHash<int, AliasRole>;
 	using RoleConverters = QHash<int, ConverterFunc>;
 	struct ColumnInfo {
 		QString name;
 		RoleMapping roles;
-		RoleConverters converters;
+		QVector<ConverterFunc> converters;
 		Qt::ItemFlags addFlags = Qt::NoItemFlags;
 		Qt::ItemFlags removeFlags = Qt::NoItemFlags;
 
@@ -74,11 +128,42 @@ private:
 			name{std::move(name)}
 		{}
 	};
+	struct AliasRef {
+		int column;
+		int aliasRole;
+	};
+	using AliasIndex = QHash<int, QVector<AliasRef>>;
+	struct PendingChange {
+		QVector<int> roles;
+		bool allRoles = false;
+		int count = 0;
+	};
 	QList<ColumnInfo> _columns;
 	RoleConverters _origRoleConverters;
-
-	QVariant dataImpl(const QModelIndex &index, int originalRole, const ColumnInfo &info, int aliasRole) const;
-	bool setDataImpl(const QModelIndex &index, QVariant value, int originalRole, const ColumnInfo &info, int aliasRole);
+	AliasIndex _aliasIndex; // original role -> all column aliases of it
+	QVector<int> _roleBuffer;
+	ColumnChangeMode _columnChangeMode = ColumnChangeMode::WidenToLastColumn;
+
+	ChangeCoalescing _coalescing = ChangeCoalescing::Immediate;
+	QTimer *_flushTimer = nullptr;
+	QMap<int, PendingChange> _pendingChanges;
+	FlushObserverFunc _flushObserver;
+
+	void queueDataChanged(int firstRow, int lastRow, const QVector<int> &roles);
+	void emitDataChangedImpl(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+	void emitColumnRuns(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+
+	template <typename TTraits, typename TRead, typename TWrite>
+	static ConverterFunc typedConverter(TRead &&read, TWrite &&write);
+	template <typename TResult, typename TArg, typename TFunc>
+	static QVariant typedConvert(const TFunc &func, const QVariant &value);
+	template <typename TResult, typename TArg, typename TSignature>
+	static QVariant typedConvert(const std::function<TSignature> &func, const QVariant &value);
+	template <typename TResult, typename TArg>
+	static QVariant typedConvert(std::nullptr_t, const QVariant &value);
+	const AliasRole *findAlias(int column, int aliasRole) const;
+	QVariant dataImpl(const QModelIndex &index, int originalRole, const ConverterFunc *aliasConverter) const;
+	bool setDataImpl(const QModelIndex &index, QVariant value, int originalRole, const ConverterFunc *aliasConverter);
 };
 
 
@@ -98,7 +183,24 @@ protected:
 template<typename TModel>
 QModelAliasBaseAdapter<TModel>::QModelAliasBaseAdapter(QObject *parent) :
 	TModel{parent}
-{}
+{
+	// pending changes refer to row numbers, so they must be flushed before the rows change
+	const auto flush = [this]() {
+		flushChanges();
+	};
+	QObject::connect(this, &QAbstractItemModel::rowsAboutToBeInserted,
+					 this, flush);
+	QObject::connect(this, &QAbstractItemModel::rowsAboutToBeRemoved,
+					 this, flush);
+	QObject::connect(this, &QAbstractItemModel::rowsAboutToBeMoved,
+					 this, flush);
+	QObject::connect(this, &QAbstractItemModel::layoutAboutToBeChanged,
+					 this, flush);
+	QObject::connect(this, &QAbstractItemModel::modelAboutToBeReset,
+					 this, [this]() {
+		_pendingChanges.clear();
+	});
+}
 
 template<typename TModel>
 int QModelAliasBaseAdapter<TModel>::columnCount(const QModelIndex &parent) const
@@ -115,17 +217,17 @@ QVariant QModelAliasBaseAdapter<TModel>::data(const QModelIndex &index, int role
 {
 	Q_ASSERT(this->checkIndex(index, QAbstractItemModel::CheckIndexOption::IndexIsValid));
 	if(_columns.isEmpty())
-		return dataImpl(index, role, {}, role);
+		return dataImpl(index, role, nullptr);
 
 	// mappings do exist -> check for one
-	const auto origRole = _columns[index.column()].roles.value(role, -1);
-	if(origRole == -1) { // no role -> -> no mapping -> forward for column 0, no data for all others
+	const auto alias = findAlias(index.column(), role);
+	if(!alias) { // no role -> -> no mapping -> forward for column 0, no data for all others
 		if(index.column() == 0)
-			return dataImpl(index, role, {}, role);
+			return dataImpl(index, role, nullptr);
 		else
 			return {};
 	} else // has role -> return data of original role at column 0
-		return dataImpl(index.siblingAtColumn(0), origRole, _columns[index.column()], role);
+		return dataImpl(index.siblingAtColumn(0), alias->originalRole, alias->converter == -1 ? nullptr : &_columns[index.column()].converters[alias->converter]);
 }
 
 template<typename TModel>
@@ -133,17 +235,17 @@ bool QModelAliasBaseAdapter<TModel>::setData(const QModelIndex &index, const QVa
 {
 	Q_ASSERT(this->checkIndex(index, QAbstractItemModel::CheckIndexOption::IndexIsValid));
 	if(_columns.isEmpty())
-		return setDataImpl(index, value, role, {}, role);
+		return setDataImpl(index, value, role, nullptr);
 
 	// mappings do exist -> check for one
-	const auto origRole = _columns[index.column()].roles.value(role, -1);
-	if(origRole == -1) { // no role -> forward for column 0, no data for all others
+	const auto alias = findAlias(index.column(), role);
+	if(!alias) { // no role -> forward for column 0, no data for all others
 		if(index.column() == 0)
-			return setDataImpl(index, value, role, {}, role);
+			return setDataImpl(index, value, role, nullptr);
 		else
 			return false;
 	} else // has role -> return data of original role at column 0
-		return setDataImpl(index.siblingAtColumn(0), value, origRole, _columns[index.column()], role);
+		return setDataImpl(index.siblingAtColumn(0), value, alias->originalRole, alias->converter == -1 ? nullptr : &qAsConst(_columns)[index.column()].converters[alias->converter]);
 }
 
 template<typename TModel>
@@ -200,7 +302,13 @@ template<typename TModel>
 void QModelAliasBaseAdapter<TModel>::insertColumn(int column, QString text)
 {
 	this->beginInsertColumns(QModelIndex{}, column, column);
-	_columns.insert(column, {std::move(text), {}});
+	_columns.insert(column, ColumnInfo{std::move(text)});
+	for(auto &aliases : _aliasIndex) {
+		for(auto &alias : aliases) {
+			if(alias.column >= column)
+				++alias.column;
+		}
+	}
 	this->endInsertColumns();
 	emit this->headerDataChanged(Qt::Horizontal, column, _columns.size() - 1);
 }
@@ -227,7 +335,16 @@ void QModelAliasBaseAdapter<TModel>::addRole(int column, int aliasRole, int orig
 				   << "Triggered for alias role" << aliasRole << ", named" << this->roleNames().value(aliasRole);
 	}
 
-	_columns[column].roles.insert(aliasRole, originalRole);
+	auto &alias = _columns[column].roles[aliasRole];
+	const auto oldRole = alias.originalRole;
+	if(oldRole != -1) {
+		auto &oldAliases = _aliasIndex[oldRole];
+		oldAliases.erase(std::remove_if(oldAliases.begin(), oldAliases.end(), [&](const AliasRef &alias) {
+			return alias.column == column && alias.aliasRole == aliasRole;
+		}), oldAliases.end());
+	}
+	alias.originalRole = originalRole;
+	_aliasIndex[originalRole].append({column, aliasRole});
 	const auto rows = this->rowCount();
 	if(rows > 0)
 		emit this->dataChanged(this->index(0, column), this->index(rows - 1, column), {aliasRole});
@@ -245,21 +362,44 @@ void QModelAliasBaseAdapter<TModel>::addSrcConverter(int originalRole, const Con
 	_origRoleConverters.insert(originalRole, converter);
 }
 
+template<typename TModel>
+template<typename TRead, typename TWrite, typename TTraits, typename>
+inline void QModelAliasBaseAdapter<TModel>::addSrcConverter(int originalRole, TRead &&read, TWrite &&write)
+{
+	addSrcConverter(originalRole, typedConverter<TTraits>(std::forward<TRead>(read), std::forward<TWrite>(write)));
+}
+
 template<typename TModel>
 void QModelAliasBaseAdapter<TModel>::addAliasConverter(int column, int aliasRole, const ConverterFunc &converter)
 {
 	Q_ASSERT_X(column < _columns.size(), Q_FUNC_INFO, "Cannot add role converter to non existant column!");
-	_columns[column].converters.insert(aliasRole, converter);
+	auto &info = _columns[column];
+	// creates an unmapped alias if the role has not been added yet
+	auto &alias = info.roles[aliasRole];
+	if(alias.converter == -1) {
+		alias.converter = info.converters.size();
+		info.converters.append(converter);
+	} else
+		info.converters[alias.converter] = converter;
+}
+
+template<typename TModel>
+template<typename TRead, typename TWrite, typename TTraits, typename>
+inline void QModelAliasBaseAdapter<TModel>::addAliasConverter(int column, int aliasRole, TRead &&read, TWrite &&write)
+{
+	addAliasConverter(column, aliasRole, typedConverter<TTraits>(std::forward<TRead>(read), std::forward<TWrite>(write)));
 }
 
 template<typename TModel>
 void QModelAliasBaseAdapter<TModel>::setExtraFlags(int column, Qt::ItemFlags addFlags, Qt::ItemFlags removeFlags)
 {
 	Q_ASSERT_X(column < _columns.size(), Q_FUNC_INFO, "Cannot add flags to non existant column!");
-	this->beginResetModel();
-	_columns[column].addFlags = addFlags;
-	_columns[column].removeFlags = removeFlags;
-	this->endResetModel();
+	auto &info = _columns[column];
+	if(info.addFlags == addFlags && info.removeFlags == removeFlags)
+		return;
+	info.addFlags = addFlags;
+	info.removeFlags = removeFlags;
+	emitFlagsChanged(column, column);
 }
 
 template<typename TModel>
@@ -267,6 +407,7 @@ void QModelAliasBaseAdapter<TModel>::clearColumns()
 {
 	this->beginRemoveColumns(QModelIndex{}, 0, _columns.size() - 1);
 	_columns.clear();
+	_aliasIndex.clear();
 	this->endRemoveColumns();
 }
 
@@ -281,7 +422,103 @@ template<typename TModel>
 int QModelAliasBaseAdapter<TModel>::resolveRole(int column, int aliasRole) const
 {
 	Q_ASSERT_X(column < _columns.size(), Q_FUNC_INFO, "Cannot return the original role of a non existant column!");
-	return _columns[column].roles.value(aliasRole, -1);
+	return _columns[column].roles.value(aliasRole).originalRole;
+}
+
+template<typename TModel>
+typename QModelAliasBaseAdapter<TModel>::ColumnChangeMode QModelAliasBaseAdapter<TModel>::columnChangeMode() const
+{
+	return _columnChangeMode;
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::setColumnChangeMode(ColumnChangeMode mode)
+{
+	_columnChangeMode = mode;
+}
+
+template<typename TModel>
+typename QModelAliasBaseAdapter<TModel>::ChangeCoalescing QModelAliasBaseAdapter<TModel>::changeCoalescing() const
+{
+	return _coalescing;
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::setChangeCoalescing(ChangeCoalescing mode, int interval)
+{
+	if(mode == ChangeCoalescing::Immediate)
+		flushChanges();
+	_coalescing = mode;
+
+	switch(_coalescing) {
+	case ChangeCoalescing::EventLoop:
+		interval = 0;
+		Q_FALLTHROUGH();
+	case ChangeCoalescing::Timer:
+		if(!_flushTimer) {
+			_flushTimer = new QTimer{this};
+			_flushTimer->setSingleShot(true);
+			QObject::connect(_flushTimer, &QTimer::timeout,
+							 this, [this]() {
+				flushChanges();
+			});
+		}
+		_flushTimer->setInterval(interval);
+		break;
+	case ChangeCoalescing::Immediate:
+	case ChangeCoalescing::Manual:
+		if(_flushTimer)
+			_flushTimer->stop();
+		break;
+	}
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::setFlushObserver(const FlushObserverFunc &observer)
+{
+	_flushObserver = observer;
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::flushChanges()
+{
+	if(_flushTimer)
+		_flushTimer->stop();
+	if(_pendingChanges.isEmpty())
+		return;
+
+	QMap<int, PendingChange> pending;
+	pending.swap(_pendingChanges);
+	const auto rows = this->rowCount();
+	auto it = pending.constBegin();
+	while(it != pending.constEnd()) {
+		// merge adjacent rows into one range
+		const auto firstRow = it.key();
+		auto lastRow = firstRow;
+		auto allRoles = it->allRoles;
+		auto roles = it->roles;
+		auto absorbed = it->count;
+		for(++it; it != pending.constEnd() && it.key() == lastRow + 1; ++it) {
+			lastRow = it.key();
+			allRoles = allRoles || it->allRoles;
+			if(!allRoles) {
+				for(auto role : it->roles) {
+					if(!roles.contains(role))
+						roles.append(role);
+				}
+			}
+			absorbed += it->count;
+		}
+		if(allRoles)
+			roles.clear();
+
+		if(firstRow >= rows)
+			continue;
+		lastRow = std::min(lastRow, rows - 1);
+		emitDataChangedImpl(this->index(firstRow, 0), this->index(lastRow, 0), roles);
+		if(_flushObserver)
+			_flushObserver(firstRow, lastRow, roles, absorbed);
+	}
 }
 
 template<typename TModel>
@@ -307,51 +544,197 @@ void QModelAliasBaseAdapter<TModel>::emitDataChanged(const QModelIndex &topLeft,
 	Q_ASSERT(this->checkIndex(bottomRight, QAbstractItemModel::CheckIndexOption::IndexIsValid));
 	Q_ASSERT_X(topLeft.column() == 0 && bottomRight.column() == 0, Q_FUNC_INFO, "emitDataChanged can only operate on indexes with column 0");
 
+	if(_coalescing == ChangeCoalescing::Immediate || topLeft.parent().isValid())
+		emitDataChangedImpl(topLeft, bottomRight, roles);
+	else
+		queueDataChanged(topLeft.row(), bottomRight.row(), roles);
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::queueDataChanged(int firstRow, int lastRow, const QVector<int> &roles)
+{
+	for(auto row = firstRow; row <= lastRow; ++row) {
+		auto &change = _pendingChanges[row];
+		if(roles.isEmpty())
+			change.allRoles = true;
+		else if(!change.allRoles) {
+			for(auto role : roles) {
+				if(!change.roles.contains(role))
+					change.roles.append(role);
+			}
+		}
+	}
+	// count each raw notification once, on the first row it touches
+	++_pendingChanges[firstRow].count;
+
+	if((_coalescing == ChangeCoalescing::EventLoop || _coalescing == ChangeCoalescing::Timer) &&
+	   !_flushTimer->isActive())
+		_flushTimer->start();
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::emitFlagsChanged(int firstColumn, int lastColumn)
+{
+	// flags are not data -> bypass coalescing and column widening, the change is exactly the given columns
+	const auto rows = this->rowCount();
+	if(rows == 0)
+		return;
+	emit this->TModel::dataChanged(this->index(0, firstColumn), this->index(rows - 1, lastColumn), {});
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::emitDataChangedImpl(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
 	if(_columns.isEmpty()) {
 		emit this->TModel::dataChanged(topLeft, bottomRight, roles);
 		return;
 	}
 
-	auto allRoles = roles;
+	// an empty role list changes every role, and thus every column
+	if(roles.isEmpty()) {
+		emit this->TModel::dataChanged(topLeft, bottomRight.siblingAtColumn(_columns.size() - 1), roles);
+		return;
+	}
+
+	if(_columnChangeMode == ColumnChangeMode::ContiguousRuns) {
+		emitColumnRuns(topLeft, bottomRight, roles);
+		return;
+	}
+
+	// the role buffer is swapped out while in use, so recursive emissions cannot corrupt it
+	QVector<int> allRoles;
+	auto hasAliases = false;
 	auto lastColumn = 0;
-	auto cCounter = 0;
-	for(const auto &columnInfo : qAsConst(_columns)) {
-		for(auto role : roles) {
-			const auto aliasRoles = columnInfo.roles.keys(role);
-			for(const auto &aliasRole : aliasRoles) {
-				lastColumn = std::max(lastColumn, cCounter);
-				if(!allRoles.contains(aliasRole))
-					allRoles.append(aliasRole);
-			}
+	for(auto role : roles) {
+		const auto it = _aliasIndex.constFind(role);
+		if(it == _aliasIndex.constEnd() || it->isEmpty())
+			continue;
+		if(!hasAliases) {
+			hasAliases = true;
+			allRoles.swap(_roleBuffer);
+			allRoles.clear();
+			for(auto originalRole : roles)
+				allRoles.append(originalRole);
+		}
+		for(const auto &alias : *it) {
+			lastColumn = std::max(lastColumn, alias.column);
+			if(!allRoles.contains(alias.aliasRole))
+				allRoles.append(alias.aliasRole);
+		}
+	}
+
+	if(hasAliases) {
+		emit this->TModel::dataChanged(topLeft, bottomRight.siblingAtColumn(lastColumn), allRoles);
+		_roleBuffer.swap(allRoles);
+	} else
+		emit this->TModel::dataChanged(topLeft, bottomRight, roles);
+}
+
+template<typename TModel>
+void QModelAliasBaseAdapter<TModel>::emitColumnRuns(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+	QVarLengthArray<AliasRef, 32> aliases;
+	for(auto role : roles) {
+		const auto it = _aliasIndex.constFind(role);
+		if(it != _aliasIndex.constEnd()) {
+			for(const auto &alias : *it)
+				aliases.append(alias);
+		}
+	}
+	std::sort(aliases.begin(), aliases.end(), [](const AliasRef &lhs, const AliasRef &rhs) {
+		return lhs.column < rhs.column;
+	});
+
+	// column 0 always holds the original roles, every other run only its alias roles
+	auto runRoles = roles;
+	auto runFirst = 0;
+	auto runLast = 0;
+	for(const auto &alias : aliases) {
+		if(alias.column > runLast + 1) {
+			emit this->TModel::dataChanged(topLeft.siblingAtColumn(runFirst), bottomRight.siblingAtColumn(runLast), runRoles);
+			runRoles.clear();
+			runFirst = alias.column;
 		}
-		++cCounter;
+		runLast = alias.column;
+		if(!runRoles.contains(alias.aliasRole))
+			runRoles.append(alias.aliasRole);
 	}
+	emit this->TModel::dataChanged(topLeft.siblingAtColumn(runFirst), bottomRight.siblingAtColumn(runLast), runRoles);
+}
+
+template<typename TModel>
+template<typename TTraits, typename TRead, typename TWrite>
+typename QModelAliasBaseAdapter<TModel>::ConverterFunc QModelAliasBaseAdapter<TModel>::typedConverter(TRead &&read, TWrite &&write)
+{
+	using TSource = typename TTraits::Source;
+	using TTarget = typename TTraits::Target;
+	return [read = std::forward<TRead>(read), write = std::forward<TWrite>(write)](Convert direction, QVariant value) -> QVariant {
+		switch(direction) {
+		case Convert::Read:
+			return typedConvert<TTarget, TSource>(read, value);
+		case Convert::Write:
+			return typedConvert<TSource, TTarget>(write, value);
+		}
+		return value;
+	};
+}
 
-	emit this->TModel::dataChanged(topLeft, bottomRight.siblingAtColumn(lastColumn), allRoles);
+template<typename TModel>
+template<typename TResult, typename TArg, typename TFunc>
+QVariant QModelAliasBaseAdapter<TModel>::typedConvert(const TFunc &func, const QVariant &value)
+{
+	return QVariant::fromValue<TResult>(func(value.value<TArg>()));
+}
+
+template<typename TModel>
+template<typename TResult, typename TArg, typename TSignature>
+QVariant QModelAliasBaseAdapter<TModel>::typedConvert(const std::function<TSignature> &func, const QVariant &value)
+{
+	if(func)
+		return QVariant::fromValue<TResult>(func(value.value<TArg>()));
+	else
+		return value;
+}
+
+template<typename TModel>
+template<typename TResult, typename TArg>
+QVariant QModelAliasBaseAdapter<TModel>::typedConvert(std::nullptr_t, const QVariant &value)
+{
+	return value;
+}
+
+template<typename TModel>
+const typename QModelAliasBaseAdapter<TModel>::AliasRole *QModelAliasBaseAdapter<TModel>::findAlias(int column, int aliasRole) const
+{
+	const auto &roles = _columns[column].roles;
+	const auto it = roles.constFind(aliasRole);
+	if(it == roles.constEnd() || it->originalRole == -1)
+		return nullptr;
+	else
+		return &(*it);
 }
 
 template<typename TModel>
-QVariant QModelAliasBaseAdapter<TModel>::dataImpl(const QModelIndex &index, int originalRole, const ColumnInfo &info, int aliasRole) const
+QVariant QModelAliasBaseAdapter<TModel>::dataImpl(const QModelIndex &index, int originalRole, const ConverterFunc *aliasConverter) const
 {
+	// converters are only ever accessed by reference, to not copy the std::functions
 	auto data = originalData(index, originalRole);
-	const auto &origConv = _origRoleConverters[originalRole];
-	if(origConv)
-		data = origConv(Convert::Read, data);
-	const auto &aliasConv = info.converters[aliasRole];
-	if(aliasConv)
-		data = aliasConv(Convert::Read, data);
+	const auto origConv = _origRoleConverters.constFind(originalRole);
+	if(origConv != _origRoleConverters.constEnd() && *origConv)
+		data = (*origConv)(Convert::Read, std::move(data));
+	if(aliasConverter && *aliasConverter)
+		data = (*aliasConverter)(Convert::Read, std::move(data));
 	return data;
 }
 
 template<typename TModel>
-bool QModelAliasBaseAdapter<TModel>::setDataImpl(const QModelIndex &index, QVariant value, int originalRole, const ColumnInfo &info, int aliasRole)
+bool QModelAliasBaseAdapter<TModel>::setDataImpl(const QModelIndex &index, QVariant value, int originalRole, const ConverterFunc *aliasConverter)
 {
-	const auto &aliasConv = info.converters[aliasRole];
-	if(aliasConv)
-		value = aliasConv(Convert::Write, value);
-	const auto &origConv = qAsConst(_origRoleConverters)[originalRole];
-	if(origConv)
-		value = origConv(Convert::Write, value);
+	if(aliasConverter && *aliasConverter)
+		value = (*aliasConverter)(Convert::Write, std::move(value));
+	const auto origConv = _origRoleConverters.constFind(originalRole);
+	if(origConv != _origRoleConverters.constEnd() && *origConv)
+		value = (*origConv)(Convert::Write, std::move(value));
 	return setOriginalData(index, value, originalRole);
 }
 
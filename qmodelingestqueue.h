@@ -0,0 +1,188 @@
+#ifndef QMODELINGESTQUEUE_H
+#define QMODELINGESTQUEUE_H
+
+#include <algorithm>
+#include <functional>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QVector>
+
+template <typename TData>
+class QModelIngestQueue
+{
+	Q_DISABLE_COPY(QModelIngestQueue)
+
+public:
+	struct Operation {
+		enum Type {
+			Append,
+			Insert,
+			Replace,
+			Remove
+		};
+
+		Type type;
+		int row;
+		TData data;
+		Operation *next;
+	};
+
+	using AppendFunc = std::function<void(QVector<TData>)>;
+	using ApplyFunc = std::function<void(Operation&)>;
+	using DisposeFunc = std::function<void(TData&)>;
+
+	QModelIngestQueue(QObject *context, AppendFunc append, ApplyFunc apply, DisposeFunc dispose = {});
+	~QModelIngestQueue();
+
+	// thread safe, never blocks
+	void push(typename Operation::Type type, int row, TData data);
+
+	int budget() const;
+	void setBudget(int msecs);
+	void drain(int msecs);
+
+private:
+	QObject *_context;
+	AppendFunc _append;
+	ApplyFunc _apply;
+	DisposeFunc _dispose;
+	int _budget = 5;
+
+	// upper bound for consecutive appends applied as one insertion while a budget is set
+	enum : int { MaxAppendBatch = 1024 };
+
+	QAtomicPointer<Operation> _head; // lock-free stack, filled by any thread
+	QAtomicInt _scheduled;
+	QVector<Operation*> _backlog; // only accessed by the context thread, in push order
+	int _backlogPos = 0;
+	bool _draining = false;
+
+	void schedule();
+	void dispose(Operation *op);
+};
+
+// ------------- Generic Implementation
+
+template <typename TData>
+QModelIngestQueue<TData>::QModelIngestQueue(QObject *context, AppendFunc append, ApplyFunc apply, DisposeFunc dispose) :
+	_context{context},
+	_append{std::move(append)},
+	_apply{std::move(apply)},
+	_dispose{std::move(dispose)}
+{}
+
+template <typename TData>
+QModelIngestQueue<TData>::~QModelIngestQueue()
+{
+	auto op = _head.fetchAndStoreAcquire(nullptr);
+	while(op) {
+		const auto next = op->next;
+		dispose(op);
+		op = next;
+	}
+	for(auto i = _backlogPos; i < _backlog.size(); ++i)
+		dispose(_backlog[i]);
+}
+
+template <typename TData>
+void QModelIngestQueue<TData>::push(typename Operation::Type type, int row, TData data)
+{
+	auto op = new Operation{type, row, std::move(data), nullptr};
+	auto head = _head.loadAcquire();
+	do {
+		op->next = head;
+	} while(!_head.testAndSetOrdered(head, op, head));
+	schedule();
+}
+
+template <typename TData>
+int QModelIngestQueue<TData>::budget() const
+{
+	return _budget;
+}
+
+template <typename TData>
+void QModelIngestQueue<TData>::setBudget(int msecs)
+{
+	_budget = msecs;
+}
+
+template <typename TData>
+void QModelIngestQueue<TData>::drain(int msecs)
+{
+	// applying an operation may re-enter via a connected slot
+	if(_draining)
+		return;
+	_draining = true;
+
+	// reset first, so operations pushed from now on schedule another drain
+	_scheduled.storeRelease(0);
+
+	// the stack returns the newest operation first -> reverse to restore the push order
+	const auto start = _backlog.size();
+	for(auto op = _head.fetchAndStoreAcquire(nullptr); op; op = op->next)
+		_backlog.append(op);
+	std::reverse(_backlog.begin() + start, _backlog.end());
+
+	QElapsedTimer timer;
+	timer.start();
+	QVector<TData> batch;
+	while(_backlogPos < _backlog.size() &&
+		  (msecs < 0 || !timer.hasExpired(msecs))) {
+		auto op = _backlog[_backlogPos++];
+		if(op->type == Operation::Append) {
+			// consecutive appends are applied as one insertion
+			batch.append(std::move(op->data));
+			delete op;
+			// bounded, so a burst of appends is spread over several drains as well
+			while(_backlogPos < _backlog.size() &&
+				  _backlog[_backlogPos]->type == Operation::Append &&
+				  (msecs < 0 || (batch.size() < MaxAppendBatch && !timer.hasExpired(msecs)))) {
+				op = _backlog[_backlogPos++];
+				batch.append(std::move(op->data));
+				delete op;
+			}
+			_append(std::move(batch));
+			batch = {};
+		} else {
+			_apply(*op);
+			delete op;
+		}
+	}
+
+	_draining = false;
+	if(_backlogPos == _backlog.size()) {
+		_backlog.clear();
+		_backlogPos = 0;
+	} else {
+		if(_backlogPos > _backlog.size() / 2) {
+			_backlog.remove(0, _backlogPos);
+			_backlogPos = 0;
+		}
+		schedule();
+	}
+}
+
+template <typename TData>
+void QModelIngestQueue<TData>::schedule()
+{
+	if(_scheduled.testAndSetOrdered(0, 1)) {
+		QMetaObject::invokeMethod(_context, [this]() {
+			drain(_budget);
+		}, Qt::QueuedConnection);
+	}
+}
+
+template <typename TData>
+void QModelIngestQueue<TData>::dispose(Operation *op)
+{
+	// operations that were never applied still own their payload
+	if(_dispose)
+		_dispose(op->data);
+	delete op;
+}
+
+#endif // QMODELINGESTQUEUE_H
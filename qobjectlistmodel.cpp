@@ -1,13 +1,65 @@
 #include "qobjectlistmodel.h"
+#include <algorithm>
 #include <QEvent>
 #include <QDynamicPropertyChangeEvent>
 #include <QMetaProperty>
+#include <QSet>
 #include "qobjectsignalhelper.h"
 
+namespace {
+
+// returns the indexes of one longest strictly increasing subsequence of values
+QVector<int> longestIncreasingSubsequence(const QVector<int> &values)
+{
+	QVector<int> tails; // tails[l]: index of the smallest tail of all subsequences with length l + 1
+	QVector<int> predecessors(values.size(), -1);
+	for(auto i = 0; i < values.size(); ++i) {
+		const auto it = std::lower_bound(tails.begin(), tails.end(), values[i], [&](int index, int value) {
+			return values[index] < value;
+		});
+		const auto length = static_cast<int>(it - tails.begin());
+		if(length > 0)
+			predecessors[i] = tails[length - 1];
+		if(it == tails.end())
+			tails.append(i);
+		else
+			*it = i;
+	}
+
+	QVector<int> result(tails.size());
+	auto index = tails.isEmpty() ? -1 : tails.last();
+	for(auto i = result.size() - 1; i >= 0; --i) {
+		result[i] = index;
+		index = predecessors[index];
+	}
+	return result;
+}
+
+}
+
 QObjectListModel::QObjectListModel(const QMetaObject *objectType, bool objectOwner, QObject *parent) :
 	QMetaObjectModel{objectType, parent},
-	_objectOwner{objectOwner}
-{}
+	_objectOwner{objectOwner},
+	_signalHelper{new QObjectSignalHelper{[this](QObject *object, const QVector<int> &roles) {
+		triggerDataChange(object, roles);
+	}, this}}
+{
+	auto role = Qt::UserRole + 1;
+	for(const auto &property : roleProperties()) {
+		if(property.hasNotifySignal())
+			_signalHelper->addSignal(role, property.notifySignal());
+		++role;
+	}
+
+	const auto keyIndex = objectType->indexOfClassInfo("QObjectListModelKey");
+	if(keyIndex != -1)
+		setKeyProperty(objectType->classInfo(keyIndex).value());
+}
+
+bool QObjectListModel::isObjectOwner() const
+{
+	return _objectOwner;
+}
 
 QObjectList QObjectListModel::objects() const
 {
@@ -35,6 +87,8 @@ QObject *QObjectListModel::takeObject(int index)
 {
 	beginRemoveRows(QModelIndex{}, index, index);
 	auto obj = _objects.takeAt(index);
+	_objectRows.remove(obj);
+	invalidateRows(index);
 	disconnectPropertyChanges(obj);
 	if(_objectOwner && obj->parent() == this)
 		obj->setParent(nullptr);
@@ -56,8 +110,13 @@ QObject *QObjectListModel::replaceObject(int index, QObject *object)
 	if(_objectOwner && oldObj->parent() == this)
 		oldObj->setParent(nullptr);
 
+	_objectRows.remove(oldObj);
+
 	// add new object
 	_objects[index] = object;
+	if(index < _indexedRows)
+		_objectRows.insert(object, index);
+	_keyedRows = std::min(_keyedRows, index);
 	if(_objectOwner)
 		object->setParent(this);
 	connectPropertyChanges(object);
@@ -76,9 +135,24 @@ int QObjectListModel::rowCount(const QModelIndex &parent) const
 		return _objects.size();
 }
 
+bool QObjectListModel::moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild)
+{
+	if(sourceParent.isValid() ||
+	   destinationParent.isValid() ||
+	   count <= 0 ||
+	   sourceRow < 0 ||
+	   sourceRow + count > _objects.size() ||
+	   destinationChild < 0 ||
+	   destinationChild > _objects.size() ||
+	   (destinationChild >= sourceRow && destinationChild <= sourceRow + count))
+		return false;
+	// destinationChild is the row to insert before, counted before the move
+	return moveObjects(sourceRow, count, destinationChild > sourceRow ? destinationChild - count : destinationChild);
+}
+
 QModelIndex QObjectListModel::index(QObject *object) const
 {
-	auto row = _objects.indexOf(object);
+	const auto row = rowOf(object);
 	if(row != -1)
 		return index(row, 0);
 	else
@@ -88,6 +162,8 @@ QModelIndex QObjectListModel::index(QObject *object) const
 void QObjectListModel::addObject(QObject *object)
 {
 	beginInsertRows(QModelIndex{}, _objects.size(), _objects.size());
+	if(_indexedRows == _objects.size())
+		_objectRows.insert(object, _indexedRows++);
 	_objects.append(object);
 	if(_objectOwner)
 		object->setParent(this);
@@ -108,6 +184,7 @@ void QObjectListModel::insertObject(int index, QObject *object)
 {
 	beginInsertRows(QModelIndex{}, index, index);
 	_objects.insert(index, object);
+	invalidateRows(index);
 	if(_objectOwner)
 		object->setParent(this);
 	connectPropertyChanges(object);
@@ -122,33 +199,217 @@ void QObjectListModel::removeObject(const QModelIndex &index)
 
 void QObjectListModel::removeObject(int index)
 {
-	beginRemoveRows(QModelIndex{}, index, index);
-	auto obj = _objects.takeAt(index);
-	if(_objectOwner && obj->parent() == this)
-		obj->deleteLater();
+	removeObjects(index, 1);
+}
+
+bool QObjectListModel::moveObject(int from, int to)
+{
+	return moveObjects(from, 1, to);
+}
+
+bool QObjectListModel::moveObjects(int first, int count, int to)
+{
+	Q_ASSERT_X(first >= 0 && count >= 0 && first + count <= _objects.size(), Q_FUNC_INFO, "Invalid source range");
+	Q_ASSERT_X(to >= 0 && to + count <= _objects.size(), Q_FUNC_INFO, "Invalid target row");
+	if(count == 0 || first == to)
+		return false;
+
+	// the objects stay connected, only their rows change
+	if(!beginMoveRows(QModelIndex{}, first, first + count - 1, QModelIndex{}, to > first ? to + count : to))
+		return false;
+	if(to > first)
+		std::rotate(_objects.begin() + first, _objects.begin() + first + count, _objects.begin() + to + count);
+	else
+		std::rotate(_objects.begin() + to, _objects.begin() + first, _objects.begin() + first + count);
+	invalidateRows(std::min(first, to));
+	endMoveRows();
+	return true;
+}
+
+void QObjectListModel::addObjects(const QObjectList &objects)
+{
+	insertObjects(_objects.size(), objects);
+}
+
+void QObjectListModel::insertObjects(int index, const QObjectList &objects)
+{
+	if(objects.isEmpty())
+		return;
+
+	beginInsertRows(QModelIndex{}, index, index + objects.size() - 1);
+	if(index == _objects.size())
+		_objects.append(objects);
 	else
+		_objects = _objects.mid(0, index) + objects + _objects.mid(index);
+	invalidateRows(index);
+	for(auto obj : objects) {
+		if(_objectOwner)
+			obj->setParent(this);
+		connectPropertyChanges(obj);
+	}
+	endInsertRows();
+}
+
+void QObjectListModel::removeObjects(int first, int count)
+{
+	if(count <= 0)
+		return;
+
+	beginRemoveRows(QModelIndex{}, first, first + count - 1);
+	const auto removed = _objects.mid(first, count);
+	_objects.erase(_objects.begin() + first, _objects.begin() + first + count);
+	invalidateRows(first);
+	for(auto obj : removed) {
+		_objectRows.remove(obj);
 		disconnectPropertyChanges(obj);
+		if(_objectOwner && obj->parent() == this)
+			releaseObject(obj);
+	}
 	endRemoveRows();
 }
 
 void QObjectListModel::resetModel(QObjectList objects)
 {
 	beginResetModel();
+	QSet<QObject*> kept;
+	kept.reserve(objects.size());
+	for(auto obj : qAsConst(objects))
+		kept.insert(obj);
 	for(auto obj : qAsConst(_objects)) {
+		disconnectPropertyChanges(obj);
 		if(_objectOwner &&
 		   obj->parent() == this &&
-		   !objects.contains(obj))
-			obj->deleteLater();
-		else
-			disconnectPropertyChanges(obj);
+		   !kept.contains(obj))
+			releaseObject(obj);
 	}
 
 	_objects = std::move(objects);
+	_objectRows.clear();
+	_indexedRows = 0;
+	_keyObjects.clear();
+	_keyedRows = 0;
 	for(auto obj : qAsConst(_objects))
 		connectPropertyChanges(obj);
 	endResetModel();
 }
 
+void QObjectListModel::syncModel(const QObjectList &objects)
+{
+	QHash<QObject*, int> targetRows;
+	targetRows.reserve(objects.size());
+	for(auto i = 0; i < objects.size(); ++i)
+		targetRows.insert(objects[i], i);
+
+	// remove all objects that are not part of the new list, in contiguous ranges from the back
+	for(auto last = _objects.size() - 1; last >= 0; --last) {
+		if(targetRows.contains(_objects[last]))
+			continue;
+		auto first = last;
+		while(first > 0 && !targetRows.contains(_objects[first - 1]))
+			--first;
+		removeObjects(first, last - first + 1);
+		last = first;
+	}
+
+	// objects that are already in the correct relative order stay where they are
+	QSet<QObject*> present;
+	QVector<int> currentTargetRows;
+	present.reserve(_objects.size());
+	currentTargetRows.reserve(_objects.size());
+	for(auto obj : qAsConst(_objects)) {
+		present.insert(obj);
+		currentTargetRows.append(targetRows.value(obj));
+	}
+	QSet<QObject*> stable;
+	const auto stableRows = longestIncreasingSubsequence(currentTargetRows);
+	stable.reserve(stableRows.size());
+	for(auto row : stableRows)
+		stable.insert(_objects[row]);
+
+	// walk the new list backwards and place every object right before its successor
+	auto anchor = _objects.size();
+	for(auto i = objects.size() - 1; i >= 0; --i) {
+		const auto obj = objects[i];
+		if(stable.contains(obj))
+			anchor = rowOf(obj);
+		else if(present.contains(obj)) {
+			const auto from = rowOf(obj);
+			if(from == anchor - 1) {
+				anchor = from;
+				continue;
+			}
+			beginMoveRows(QModelIndex{}, from, from, QModelIndex{}, anchor);
+			const auto to = from < anchor ? anchor - 1 : anchor;
+			_objects.move(from, to);
+			invalidateRows(std::min(from, to));
+			endMoveRows();
+			anchor = to;
+		} else {
+			auto first = i;
+			while(first > 0 && !present.contains(objects[first - 1]))
+				--first;
+			insertObjects(anchor, objects.mid(first, i - first + 1));
+			i = first;
+		}
+	}
+}
+
+QByteArray QObjectListModel::keyProperty() const
+{
+	return _keyProperty ? QByteArray{_keyProperty->name()} : QByteArray{};
+}
+
+void QObjectListModel::setKeyProperty(const QByteArray &name)
+{
+	_keyProperty = propertyForRole(Qt::UserRole + 1 + metaType()->indexOfProperty(name.constData()));
+	Q_ASSERT_X(_keyProperty || name.isEmpty(), Q_FUNC_INFO, "The key must be a property of the object type");
+	_keyObjects.clear();
+	_keyedRows = 0;
+}
+
+QObject *QObjectListModel::objectByKey(const QVariant &key) const
+{
+	Q_ASSERT_X(_keyProperty, Q_FUNC_INFO, "No key property has been set");
+	const auto row = rowOfKey(normalizedKey(key));
+	return row != -1 ? _objects[row] : nullptr;
+}
+
+QObject *QObjectListModel::upsert(const QVariantMap &values)
+{
+	Q_ASSERT_X(_keyProperty, Q_FUNC_INFO, "No key property has been set");
+	return upsertImpl(normalizedKey(values.value(QString::fromUtf8(_keyProperty->name()))),
+					  [&](const QMetaProperty &property, QVariant &value) {
+		const auto it = values.constFind(QString::fromUtf8(property.name()));
+		if(it == values.constEnd())
+			return false;
+		value = *it;
+		return true;
+	});
+}
+
+QObject *QObjectListModel::upsert(QObject *object)
+{
+	Q_ASSERT_X(_keyProperty, Q_FUNC_INFO, "No key property has been set");
+	const auto key = keyOf(object);
+	const auto row = rowOfKey(key);
+	if(row == -1) {
+		addObject(object);
+		return object;
+	} else if(_objects[row] == object)
+		return object;
+
+	const auto target = upsertImpl(key, [object](const QMetaProperty &property, QVariant &value) {
+		value = property.read(object);
+		return true;
+	});
+	// the values have been merged into the existing object, so the given one is not needed anymore
+	if(_objectOwner) {
+		object->setParent(this);
+		releaseObject(object);
+	}
+	return target;
+}
+
 QVariant QObjectListModel::readProperty(int row, const QMetaProperty &property) const
 {
 	return property.read(_objects[row]);
@@ -156,29 +417,167 @@ QVariant QObjectListModel::readProperty(int row, const QMetaProperty &property)
 
 bool QObjectListModel::writeProperty(int row, const QMetaProperty &property, const QVariant &data)
 {
+	if(_keyProperty && property.propertyIndex() == _keyProperty->propertyIndex())
+		_keyedRows = std::min(_keyedRows, row);
 	return property.write(_objects[row], data);
 }
 
-void QObjectListModel::registerSignalHelper(int role, const QMetaMethod &signal)
+void QObjectListModel::releaseObject(QObject *object)
+{
+	object->deleteLater();
+}
+
+QObject *QObjectListModel::createObject()
+{
+	return metaType()->newInstance();
+}
+
+int QObjectListModel::rowOf(QObject *object) const
+{
+	// rows below _indexedRows are always up to date, everything above is indexed lazily
+	const auto it = _objectRows.constFind(object);
+	if(it != _objectRows.constEnd() &&
+	   *it < _indexedRows &&
+	   _objects[*it] == object)
+		return *it;
+
+	while(_indexedRows < _objects.size()) {
+		const auto row = _indexedRows++;
+		const auto obj = _objects[row];
+		_objectRows.insert(obj, row);
+		if(obj == object)
+			return row;
+	}
+	return -1;
+}
+
+int QObjectListModel::rowOfKey(const QString &key) const
+{
+	// like rowOf: keys of rows below _keyedRows are indexed, entries are verified as objects or keys may have changed
+	const auto it = _keyObjects.constFind(key);
+	if(it != _keyObjects.constEnd()) {
+		const auto row = rowOf(*it);
+		if(row != -1 &&
+		   row < _keyedRows &&
+		   keyOf(*it) == key)
+			return row;
+		_keyObjects.remove(key);
+	}
+
+	while(_keyedRows < _objects.size()) {
+		const auto row = _keyedRows++;
+		const auto obj = _objects[row];
+		const auto objKey = keyOf(obj);
+		_keyObjects.insert(objKey, obj);
+		if(objKey == key)
+			return row;
+	}
+	return -1;
+}
+
+QString QObjectListModel::keyOf(QObject *object) const
+{
+	return _keyProperty->read(object).toString();
+}
+
+QString QObjectListModel::normalizedKey(const QVariant &key) const
+{
+	// compare keys as the property stores them, e.g. "01" and 1 are the same int key
+	auto converted = key;
+	if(converted.userType() != _keyProperty->userType() &&
+	   converted.convert(_keyProperty->userType()))
+		return converted.toString();
+	else
+		return key.toString();
+}
+
+QObject *QObjectListModel::upsertImpl(const QString &key, const std::function<bool(const QMetaProperty&, QVariant&)> &valueFor)
+{
+	auto row = rowOfKey(key);
+	if(row == -1) {
+		const auto obj = createObject();
+		if(!obj)
+			return nullptr;
+		QVariant value;
+		for(const auto &property : roleProperties()) {
+			if(property.isWritable() && valueFor(property, value))
+				property.write(obj, value);
+		}
+		const auto wasIndexed = _keyedRows == _objects.size();
+		addObject(obj);
+		// keep the key index complete for consecutive upserts of new keys, using the key as written
+		if(wasIndexed) {
+			_keyObjects.insert(keyOf(obj), obj);
+			++_keyedRows;
+		}
+		return obj;
+	}
+
+	// only write what differs, and report all changes at once instead of once per notify signal
+	const auto obj = _objects[row];
+	QVector<int> roles;
+	QVariant value;
+	_silencedObject = obj;
+	auto role = Qt::UserRole + 1;
+	for(const auto &property : roleProperties()) {
+		if(property.propertyIndex() != _keyProperty->propertyIndex() &&
+		   property.isWritable() &&
+		   valueFor(property, value)) {
+			if(value.userType() != property.userType())
+				value.convert(property.userType());
+			if(property.read(obj) != value &&
+			   property.write(obj, value))
+				roles.append(role);
+		}
+		++role;
+	}
+	_silencedObject = nullptr;
+	// writes may change other properties as a side effect, report those as well
+	for(auto silencedRole : qAsConst(_silencedRoles)) {
+		if(!roles.contains(silencedRole))
+			roles.append(silencedRole);
+	}
+	_silencedRoles.clear();
+
+	if(!roles.isEmpty())
+		emitDataChanged(index(row, 0), index(row, 0), roles);
+	return obj;
+}
+
+void QObjectListModel::invalidateRows(int fromRow)
 {
-	_propertyHelpers.insert(new QObjectSignalHelper{role, signal, this});
+	_indexedRows = std::min(_indexedRows, fromRow);
+	_keyedRows = std::min(_keyedRows, fromRow);
 }
 
 void QObjectListModel::connectPropertyChanges(QObject *object)
 {
-	for(auto helper : qAsConst(_propertyHelpers))
-		helper->addObject(object);
+	_signalHelper->addObject(object);
 }
 
 void QObjectListModel::disconnectPropertyChanges(QObject *object)
 {
-	for(auto helper : qAsConst(_propertyHelpers))
-		helper->removeObject(object);
+	_signalHelper->removeObject(object);
 }
 
-void QObjectListModel::triggerDataChange(QObject *object, int role)
+void QObjectListModel::triggerDataChange(QObject *object, const QVector<int> &roles)
 {
 	auto mIndex = index(object);
-	if(mIndex.isValid())
-		emitDataChanged(mIndex, mIndex, {role});
+	if(!mIndex.isValid())
+		return;
+
+	if(_keyProperty &&
+	   std::any_of(roles.begin(), roles.end(), [this](int role) {
+		   return propertyForRole(role) == _keyProperty;
+	   }))
+		_keyedRows = std::min(_keyedRows, mIndex.row());
+	// collected by upsert and reported together with its own changes
+	if(object == _silencedObject) {
+		for(auto role : roles) {
+			if(!_silencedRoles.contains(role))
+				_silencedRoles.append(role);
+		}
+		return;
+	}
+	emitDataChanged(mIndex, mIndex, roles);
 }
@@ -1,6 +1,8 @@
 #ifndef QOBJECTLISTMODEL_H
 #define QOBJECTLISTMODEL_H
 
+#include <functional>
+
 #include "qmetaobjectmodel.h"
 
 class QObjectSignalHelper;
@@ -13,6 +15,7 @@ public:
 							  bool objectOwner = true,
 							  QObject *parent = nullptr);
 
+	bool isObjectOwner() const;
 	Q_INVOKABLE QObjectList objects() const;
 	QObject *object(const QModelIndex &index) const;
 	Q_INVOKABLE QObject *object(int index) const;
@@ -22,31 +25,59 @@ public:
 	Q_INVOKABLE QObject *replaceObject(int index, QObject *object);
 
 	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	bool moveRows(const QModelIndex &sourceParent, int sourceRow, int count, const QModelIndex &destinationParent, int destinationChild) override;
 	using QMetaObjectModel::index;
 	QModelIndex index(QObject *object) const;
 
+	QByteArray keyProperty() const;
+	void setKeyProperty(const QByteArray &name);
+	Q_INVOKABLE QObject *objectByKey(const QVariant &key) const;
+
 public Q_SLOTS:
 	void addObject(QObject *object);
 	void insertObject(const QModelIndex &index, QObject *object);
 	void insertObject(int index, QObject *object);
 	void removeObject(const QModelIndex &index);
 	void removeObject(int index);
+	void addObjects(const QObjectList &objects);
+	void insertObjects(int index, const QObjectList &objects);
+	void removeObjects(int first, int count);
+	bool moveObject(int from, int to);
+	bool moveObjects(int first, int count, int to);
 	void resetModel(QObjectList objects = {});
+	void syncModel(const QObjectList &objects);
+	QObject *upsert(const QVariantMap &values);
+	QObject *upsert(QObject *object);
 
 protected:
 	QVariant readProperty(int row, const QMetaProperty &property) const override;
 	bool writeProperty(int row, const QMetaProperty &property, const QVariant &data) override;
-	void registerSignalHelper(int role, const QMetaMethod &signal) override;
+	// called for owned objects that are removed from the model, after they have been disconnected
+	virtual void releaseObject(QObject *object);
+	// called by upsert for new keys, the default uses QMetaObject::newInstance
+	virtual QObject *createObject();
 
 private:
-	friend class QObjectSignalHelper;
 	bool _objectOwner;
 	QObjectList _objects;
-	QSet<QObjectSignalHelper*> _propertyHelpers;
+	QObjectSignalHelper *_signalHelper;
+	mutable QHash<QObject*, int> _objectRows;
+	mutable int _indexedRows = 0;
+	const QMetaProperty *_keyProperty = nullptr;
+	mutable QHash<QString, QObject*> _keyObjects;
+	mutable int _keyedRows = 0;
+	QObject *_silencedObject = nullptr;
+	QVector<int> _silencedRoles;
 
+	int rowOf(QObject *object) const;
+	int rowOfKey(const QString &key) const;
+	QString keyOf(QObject *object) const;
+	QString normalizedKey(const QVariant &key) const;
+	QObject *upsertImpl(const QString &key, const std::function<bool(const QMetaProperty&, QVariant&)> &valueFor);
+	void invalidateRows(int fromRow);
 	void connectPropertyChanges(QObject *object);
 	void disconnectPropertyChanges(QObject *object);
-	void triggerDataChange(QObject *object, int role);
+	void triggerDataChange(QObject *object, const QVector<int> &roles);
 };
 
 Q_DECLARE_METATYPE(QObjectListModel*)
@@ -1,15 +1,21 @@
 HEADERS += \
 	$$PWD/qobjectlistmodel.h \
+	$$PWD/qpagedobjectlistmodel.h \
 	$$PWD/qobjectproxymodel.h \
+	$$PWD/qobjectsortfilterproxymodel.h \
 	$$PWD/qobjectsignalhelper.h \
 	$$PWD/qgadgetlistmodel.h \
 	$$PWD/qmodelaliasadapter.h \
+	$$PWD/qmodelingestqueue.h \
 	$$PWD/qmetaobjectmodel.h \
-	$$PWD/qgenericlistmodel.h
+	$$PWD/qgenericlistmodel.h \
+	$$PWD/qcolumnargadgetlistmodel.h
 
 SOURCES += \
 	$$PWD/qobjectlistmodel.cpp \
+	$$PWD/qpagedobjectlistmodel.cpp \
 	$$PWD/qobjectproxymodel.cpp \
+	$$PWD/qobjectsortfilterproxymodel.cpp \
 	$$PWD/qobjectsignalhelper.cpp \
 	$$PWD/qmetaobjectmodel.cpp
 
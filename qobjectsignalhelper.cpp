@@ -1,17 +1,27 @@
 #include "qobjectsignalhelper.h"
-#include <QVector>
 
-QObjectSignalHelper::QObjectSignalHelper(int role, QMetaMethod signal, QObjectListModel *parent) :
+QObjectSignalHelper::QObjectSignalHelper(ChangeFunc onChange, QObject *parent) :
 	QObject{parent},
-	_model{parent},
-	_role{role},
-	_signal{std::move(signal)}
+	_onChange{std::move(onChange)},
+	_slotIndex{staticMetaObject.indexOfSlot("propertyChanged()")}
 {}
 
+void QObjectSignalHelper::addSignal(int role, const QMetaMethod &signal)
+{
+	const auto signalIndex = signal.methodIndex();
+	if(_signalRoles.size() <= signalIndex)
+		_signalRoles.resize(signalIndex + 1);
+	auto &roles = _signalRoles[signalIndex];
+	if(roles.isEmpty())
+		_signalIndexes.append(signalIndex);
+	if(!roles.contains(role))
+		roles.append(role);
+}
+
 void QObjectSignalHelper::addObject(QObject *object)
 {
-	auto slot = metaObject()->method(metaObject()->indexOfSlot("propertyChanged()"));
-	connect(object, _signal, this, slot);
+	for(auto signalIndex : qAsConst(_signalIndexes))
+		QMetaObject::connect(object, signalIndex, this, _slotIndex);
 }
 
 void QObjectSignalHelper::removeObject(QObject *object)
@@ -21,5 +31,10 @@ void QObjectSignalHelper::removeObject(QObject *object)
 
 void QObjectSignalHelper::propertyChanged()
 {
-	_model->triggerDataChange(sender(), _role);
+	const auto signalIndex = senderSignalIndex();
+	if(signalIndex >= 0 && signalIndex < _signalRoles.size()) {
+		const auto &roles = _signalRoles[signalIndex];
+		if(!roles.isEmpty())
+			_onChange(sender(), roles);
+	}
 }
@@ -1,16 +1,21 @@
 #ifndef QOBJECTSIGNALHELPER_H
 #define QOBJECTSIGNALHELPER_H
 
-#include "qobjectlistmodel.h"
+#include <functional>
 
 #include <QMetaProperty>
 #include <QObject>
+#include <QVector>
 
 class Q_QOBJECT_LIST_MODEL_EXPORT QObjectSignalHelper : public QObject
 {
 	Q_OBJECT
 public:
-	explicit QObjectSignalHelper(int role, QMetaMethod signal, QObjectListModel *parent = nullptr);
+	using ChangeFunc = std::function<void(QObject*, const QVector<int>&)>; // object, roles
+
+	explicit QObjectSignalHelper(ChangeFunc onChange, QObject *parent = nullptr);
+
+	void addSignal(int role, const QMetaMethod &signal);
 
 	void addObject(QObject *object);
 	void removeObject(QObject *object);
@@ -19,9 +24,10 @@ private Q_SLOTS:
 	void propertyChanged();
 
 private:
-	QObjectListModel *_model;
-	const int _role;
-	const QMetaMethod _signal;
+	ChangeFunc _onChange;
+	const int _slotIndex;
+	QVector<int> _signalIndexes; // each signal only once, even if shared by several properties
+	QVector<QVector<int>> _signalRoles; // index: signal method index, value: roles of all properties notified by it
 };
 
 #endif // QOBJECTSIGNALHELPER_H
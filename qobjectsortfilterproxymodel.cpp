@@ -0,0 +1,585 @@
+#include "qobjectsortfilterproxymodel.h"
+
+#include <algorithm>
+#include <QDateTime>
+
+namespace {
+
+// more separate insertions than this are reported as one layout change instead
+const int MaxInsertRanges = 16;
+
+bool isNumber(int type)
+{
+	switch(type) {
+	case QMetaType::Bool:
+	case QMetaType::Int:
+	case QMetaType::UInt:
+	case QMetaType::Long:
+	case QMetaType::ULong:
+	case QMetaType::LongLong:
+	case QMetaType::ULongLong:
+	case QMetaType::Short:
+	case QMetaType::UShort:
+	case QMetaType::Char:
+	case QMetaType::SChar:
+	case QMetaType::UChar:
+	case QMetaType::Float:
+	case QMetaType::Double:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool defaultLessThan(const QVariant &lhs, const QVariant &rhs)
+{
+	if(isNumber(lhs.userType()) && isNumber(rhs.userType()))
+		return lhs.toDouble() < rhs.toDouble();
+
+	switch(lhs.userType()) {
+	case QMetaType::QDate:
+		return lhs.toDate() < rhs.toDate();
+	case QMetaType::QTime:
+		return lhs.toTime() < rhs.toTime();
+	case QMetaType::QDateTime:
+		return lhs.toDateTime() < rhs.toDateTime();
+	default:
+		return QString::compare(lhs.toString(), rhs.toString()) < 0;
+	}
+}
+
+}
+
+QObjectSortFilterProxyModel::QObjectSortFilterProxyModel(QObject *parent) :
+	QAbstractProxyModel{parent},
+	_lessThan{defaultLessThan}
+{}
+
+QModelIndex QObjectSortFilterProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+	Q_ASSERT(checkIndex(parent, CheckIndexOption::NoOption));
+	if(parent.isValid() ||
+	   row < 0 || row >= rowCount() ||
+	   column < 0 || column >= columnCount())
+		return {};
+	else
+		return createIndex(row, column);
+}
+
+QModelIndex QObjectSortFilterProxyModel::parent(const QModelIndex &) const
+{
+	return {};
+}
+
+int QObjectSortFilterProxyModel::rowCount(const QModelIndex &parent) const
+{
+	Q_ASSERT(checkIndex(parent, CheckIndexOption::DoNotUseParent));
+	if(parent.isValid())
+		return 0;
+	else
+		return _proxyToSource.size();
+}
+
+int QObjectSortFilterProxyModel::columnCount(const QModelIndex &parent) const
+{
+	Q_ASSERT(checkIndex(parent, CheckIndexOption::DoNotUseParent));
+	if(parent.isValid() || !sourceModel())
+		return 0;
+	else
+		return sourceModel()->columnCount();
+}
+
+QHash<int, QByteArray> QObjectSortFilterProxyModel::roleNames() const
+{
+	return sourceModel() ? sourceModel()->roleNames() : QHash<int, QByteArray>{};
+}
+
+void QObjectSortFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+	_sortColumn = column;
+	_sortOrder = order;
+	resort();
+}
+
+void QObjectSortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+	beginResetModel();
+	for(const auto &connection : qAsConst(_sourceConnections))
+		disconnect(connection);
+	_sourceConnections.clear();
+
+	QAbstractProxyModel::setSourceModel(sourceModel);
+
+	if(sourceModel) {
+		_sourceConnections = {
+			connect(sourceModel, &QAbstractItemModel::dataChanged,
+					this, &QObjectSortFilterProxyModel::sourceDataChanged),
+			connect(sourceModel, &QAbstractItemModel::rowsInserted,
+					this, &QObjectSortFilterProxyModel::sourceRowsInserted),
+			connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved,
+					this, &QObjectSortFilterProxyModel::sourceRowsAboutToBeRemoved),
+			connect(sourceModel, &QAbstractItemModel::rowsRemoved,
+					this, &QObjectSortFilterProxyModel::sourceRowsRemoved),
+			connect(sourceModel, &QAbstractItemModel::headerDataChanged,
+					this, &QObjectSortFilterProxyModel::sourceHeaderDataChanged),
+			connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset,
+					this, [this]() {
+				beginResetModel();
+			}),
+			connect(sourceModel, &QAbstractItemModel::modelReset,
+					this, [this]() {
+				rebuild();
+				endResetModel();
+			}),
+			connect(sourceModel, &QAbstractItemModel::rowsAboutToBeMoved,
+					this, [this]() {
+				sourceLayoutAboutToBeChanged();
+			}),
+			connect(sourceModel, &QAbstractItemModel::rowsMoved,
+					this, &QObjectSortFilterProxyModel::sourceRowsMoved),
+			connect(sourceModel, &QAbstractItemModel::layoutAboutToBeChanged,
+					this, &QObjectSortFilterProxyModel::sourceLayoutAboutToBeChanged),
+			connect(sourceModel, &QAbstractItemModel::layoutChanged,
+					this, &QObjectSortFilterProxyModel::sourceLayoutChanged),
+			connect(sourceModel, &QAbstractItemModel::columnsInserted,
+					this, &QObjectSortFilterProxyModel::invalidate),
+			connect(sourceModel, &QAbstractItemModel::columnsRemoved,
+					this, &QObjectSortFilterProxyModel::invalidate)
+		};
+	}
+
+	rebuild();
+	endResetModel();
+}
+
+QModelIndex QObjectSortFilterProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+	Q_ASSERT(checkIndex(proxyIndex, CheckIndexOption::NoOption));
+	if(!sourceModel() || !proxyIndex.isValid())
+		return {};
+	else
+		return sourceModel()->index(_proxyToSource[proxyIndex.row()], proxyIndex.column());
+}
+
+QModelIndex QObjectSortFilterProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+	if(!sourceModel() || !sourceIndex.isValid() || sourceIndex.parent().isValid())
+		return {};
+	const auto proxyRow = _sourceToProxy.value(sourceIndex.row(), -1);
+	if(proxyRow == -1)
+		return {};
+	else
+		return index(proxyRow, sourceIndex.column());
+}
+
+int QObjectSortFilterProxyModel::sortColumn() const
+{
+	return _sortColumn;
+}
+
+Qt::SortOrder QObjectSortFilterProxyModel::sortOrder() const
+{
+	return _sortOrder;
+}
+
+int QObjectSortFilterProxyModel::sortRole() const
+{
+	return _sortRole;
+}
+
+void QObjectSortFilterProxyModel::setSortRole(int role)
+{
+	if(_sortRole == role)
+		return;
+	_sortRole = role;
+	if(_sortColumn >= 0)
+		resort();
+}
+
+void QObjectSortFilterProxyModel::setLessThan(const LessThanFunc &lessThan)
+{
+	_lessThan = lessThan ? lessThan : LessThanFunc{defaultLessThan};
+	if(_sortColumn >= 0)
+		resort();
+}
+
+void QObjectSortFilterProxyModel::setFilter(const FilterFunc &filter, const QVector<int> &filterRoles)
+{
+	_filter = filter;
+	_filterRoles = filterRoles;
+	invalidate();
+}
+
+void QObjectSortFilterProxyModel::invalidate()
+{
+	beginResetModel();
+	rebuild();
+	endResetModel();
+}
+
+void QObjectSortFilterProxyModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+	if(topLeft.parent().isValid())
+		return;
+
+	// only rows whose changed roles intersect the sort or filter roles are re-evaluated
+	const auto sortChanged = _sortColumn >= 0 &&
+							 topLeft.column() <= _sortColumn &&
+							 bottomRight.column() >= _sortColumn &&
+							 (roles.isEmpty() || roles.contains(_sortRole));
+	const auto filterChanged = _filter &&
+							   (roles.isEmpty() ||
+								_filterRoles.isEmpty() ||
+								std::any_of(roles.begin(), roles.end(), [this](int role) {
+									return _filterRoles.contains(role);
+								}));
+
+	QVector<int> changedRows;
+	QVector<int> acceptedRows;
+	for(auto row = topLeft.row(); row <= bottomRight.row(); ++row) {
+		if(sortChanged)
+			_sortKeys[row] = sortKey(row);
+		if(filterChanged) {
+			const auto accepted = filterAcceptsRow(row);
+			const auto visible = _sourceToProxy[row] != -1;
+			if(accepted && !visible) {
+				acceptedRows.append(row);
+				continue;
+			} else if(!accepted && visible) {
+				removeProxyRow(row);
+				continue;
+			}
+		}
+		if(sortChanged)
+			repositionProxyRow(row);
+		if(_sourceToProxy[row] != -1)
+			changedRows.append(row);
+	}
+
+	insertProxyRows(std::move(acceptedRows));
+
+	// forward the change for contiguous proxy row ranges
+	for(auto &row : changedRows)
+		row = _sourceToProxy[row];
+	std::sort(changedRows.begin(), changedRows.end());
+	for(auto i = 0; i < changedRows.size();) {
+		auto last = i;
+		while(last + 1 < changedRows.size() && changedRows[last + 1] == changedRows[last] + 1)
+			++last;
+		emit dataChanged(index(changedRows[i], topLeft.column()),
+						 index(changedRows[last], bottomRight.column()),
+						 roles);
+		i = last + 1;
+	}
+}
+
+void QObjectSortFilterProxyModel::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+	if(parent.isValid())
+		return;
+
+	const auto count = last - first + 1;
+	for(auto &sourceRow : _proxyToSource) {
+		if(sourceRow >= first)
+			sourceRow += count;
+	}
+	_sortKeys.insert(first, count, QVariant{});
+	_sourceToProxy.insert(first, count, -1);
+
+	QVector<int> acceptedRows;
+	acceptedRows.reserve(count);
+	for(auto row = first; row <= last; ++row) {
+		if(_sortColumn >= 0)
+			_sortKeys[row] = sortKey(row);
+		if(filterAcceptsRow(row))
+			acceptedRows.append(row);
+	}
+	insertProxyRows(std::move(acceptedRows));
+}
+
+void QObjectSortFilterProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+	if(parent.isValid())
+		return;
+
+	for(auto row = last; row >= first; --row) {
+		if(_sourceToProxy[row] != -1)
+			removeProxyRow(row);
+	}
+}
+
+void QObjectSortFilterProxyModel::sourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+	if(parent.isValid())
+		return;
+
+	const auto count = last - first + 1;
+	_sortKeys.remove(first, count);
+	_sourceToProxy.remove(first, count);
+	for(auto &sourceRow : _proxyToSource) {
+		if(sourceRow > last)
+			sourceRow -= count;
+	}
+}
+
+void QObjectSortFilterProxyModel::sourceRowsMoved(const QModelIndex &sourceParent, int sourceStart, int sourceEnd, const QModelIndex &destinationParent, int destinationRow)
+{
+	if(sourceParent.isValid() || destinationParent.isValid()) {
+		finishSourceLayoutChange();
+		return;
+	}
+
+	// the rows only change their position, so the sort keys and filter results are moved instead of evaluated again
+	const auto count = sourceEnd - sourceStart + 1;
+	const auto movedTo = destinationRow > sourceStart ? destinationRow - count : destinationRow;
+	const auto mapRow = [&](int row) {
+		if(row >= sourceStart && row <= sourceEnd)
+			return movedTo + row - sourceStart;
+		else if(destinationRow > sourceEnd && row > sourceEnd && row < destinationRow)
+			return row - count;
+		else if(destinationRow < sourceStart && row >= destinationRow && row < sourceStart)
+			return row + count;
+		else
+			return row;
+	};
+
+	QVector<QVariant> sortKeys(_sortKeys.size());
+	for(auto row = 0; row < _sortKeys.size(); ++row)
+		sortKeys[mapRow(row)] = std::move(_sortKeys[row]);
+	_sortKeys.swap(sortKeys);
+	for(auto &sourceRow : _proxyToSource)
+		sourceRow = mapRow(sourceRow);
+	// the source row breaks ties, so the proxy order can change even if sorted
+	std::sort(_proxyToSource.begin(), _proxyToSource.end(), [this](int lhs, int rhs) {
+		return rowLessThan(lhs, rhs);
+	});
+	_sourceToProxy.fill(-1);
+	updateSourceToProxy(0, _proxyToSource.size() - 1);
+
+	finishSourceLayoutChange();
+}
+
+void QObjectSortFilterProxyModel::sourceLayoutAboutToBeChanged()
+{
+	// remember the source indexes, they are updated by the source model
+	emit layoutAboutToBeChanged();
+	_layoutProxyIndexes = persistentIndexList();
+	_layoutSourceIndexes.clear();
+	_layoutSourceIndexes.reserve(_layoutProxyIndexes.size());
+	for(const auto &proxyIndex : qAsConst(_layoutProxyIndexes))
+		_layoutSourceIndexes.append(mapToSource(proxyIndex));
+}
+
+void QObjectSortFilterProxyModel::sourceLayoutChanged()
+{
+	// the new row order is unknown, so everything is evaluated again
+	rebuild();
+	finishSourceLayoutChange();
+}
+
+void QObjectSortFilterProxyModel::sourceHeaderDataChanged(Qt::Orientation orientation, int first, int last)
+{
+	if(orientation == Qt::Horizontal)
+		emit headerDataChanged(orientation, first, last);
+}
+
+QVariant QObjectSortFilterProxyModel::sortKey(int sourceRow) const
+{
+	return sourceModel()->data(sourceModel()->index(sourceRow, _sortColumn), _sortRole);
+}
+
+bool QObjectSortFilterProxyModel::filterAcceptsRow(int sourceRow) const
+{
+	return !_filter || _filter(sourceModel(), sourceRow);
+}
+
+bool QObjectSortFilterProxyModel::rowLessThan(int lhsSourceRow, int rhsSourceRow) const
+{
+	// the source row is the tie breaker, so the order is strict and binary searchable
+	if(_sortColumn >= 0) {
+		const auto &lhs = _sortKeys[lhsSourceRow];
+		const auto &rhs = _sortKeys[rhsSourceRow];
+		if(_lessThan(lhs, rhs))
+			return _sortOrder == Qt::AscendingOrder;
+		else if(_lessThan(rhs, lhs))
+			return _sortOrder == Qt::DescendingOrder;
+	}
+	return lhsSourceRow < rhsSourceRow;
+}
+
+int QObjectSortFilterProxyModel::insertPosition(int sourceRow, int first, int last) const
+{
+	const auto begin = _proxyToSource.constBegin();
+	return static_cast<int>(std::lower_bound(begin + first, begin + last, sourceRow, [this](int lhs, int rhs) {
+		return rowLessThan(lhs, rhs);
+	}) - begin);
+}
+
+void QObjectSortFilterProxyModel::rebuild()
+{
+	_proxyToSource.clear();
+	_sortKeys.clear();
+	_sourceToProxy.clear();
+	if(!sourceModel())
+		return;
+
+	const auto rows = sourceModel()->rowCount();
+	_sortKeys.resize(rows);
+	_sourceToProxy.fill(-1, rows);
+	_proxyToSource.reserve(rows);
+	for(auto row = 0; row < rows; ++row) {
+		if(_sortColumn >= 0)
+			_sortKeys[row] = sortKey(row);
+		if(filterAcceptsRow(row))
+			_proxyToSource.append(row);
+	}
+	if(_sortColumn >= 0) {
+		std::sort(_proxyToSource.begin(), _proxyToSource.end(), [this](int lhs, int rhs) {
+			return rowLessThan(lhs, rhs);
+		});
+	}
+	updateSourceToProxy(0, _proxyToSource.size() - 1);
+}
+
+void QObjectSortFilterProxyModel::resort()
+{
+	if(!sourceModel())
+		return;
+
+	emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+	const auto oldIndexes = persistentIndexList();
+	QVector<int> sourceRows;
+	sourceRows.reserve(oldIndexes.size());
+	for(const auto &oldIndex : oldIndexes)
+		sourceRows.append(_proxyToSource[oldIndex.row()]);
+
+	if(_sortColumn >= 0) {
+		for(auto row = 0; row < _sortKeys.size(); ++row)
+			_sortKeys[row] = sortKey(row);
+	}
+	std::sort(_proxyToSource.begin(), _proxyToSource.end(), [this](int lhs, int rhs) {
+		return rowLessThan(lhs, rhs);
+	});
+	updateSourceToProxy(0, _proxyToSource.size() - 1);
+
+	QModelIndexList newIndexes;
+	newIndexes.reserve(oldIndexes.size());
+	for(auto i = 0; i < oldIndexes.size(); ++i)
+		newIndexes.append(index(_sourceToProxy[sourceRows[i]], oldIndexes[i].column()));
+	changePersistentIndexList(oldIndexes, newIndexes);
+	emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void QObjectSortFilterProxyModel::finishSourceLayoutChange()
+{
+	QModelIndexList newIndexes;
+	newIndexes.reserve(_layoutSourceIndexes.size());
+	for(const auto &sourceIndex : qAsConst(_layoutSourceIndexes))
+		newIndexes.append(mapFromSource(sourceIndex));
+	changePersistentIndexList(_layoutProxyIndexes, newIndexes);
+	_layoutProxyIndexes.clear();
+	_layoutSourceIndexes.clear();
+	emit layoutChanged();
+}
+
+void QObjectSortFilterProxyModel::updateSourceToProxy(int firstProxyRow, int lastProxyRow)
+{
+	for(auto proxyRow = firstProxyRow; proxyRow <= lastProxyRow; ++proxyRow)
+		_sourceToProxy[_proxyToSource[proxyRow]] = proxyRow;
+}
+
+void QObjectSortFilterProxyModel::insertProxyRows(QVector<int> sourceRows)
+{
+	if(sourceRows.isEmpty())
+		return;
+
+	const auto lessThan = [this](int lhs, int rhs) {
+		return rowLessThan(lhs, rhs);
+	};
+	std::sort(sourceRows.begin(), sourceRows.end(), lessThan);
+
+	// the final proxy row of every new row, ascending as the rows are sorted
+	QVector<int> proxyRows;
+	proxyRows.reserve(sourceRows.size());
+	auto position = 0;
+	auto ranges = 0;
+	for(auto i = 0; i < sourceRows.size(); ++i) {
+		position = insertPosition(sourceRows[i], position, _proxyToSource.size());
+		proxyRows.append(position + i);
+		if(i == 0 || proxyRows[i] != proxyRows[i - 1] + 1)
+			++ranges;
+	}
+
+	if(ranges > MaxInsertRanges) {
+		// merge everything at once, instead of shifting the mapping for every range
+		emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+		const auto oldIndexes = persistentIndexList();
+		QVector<int> oldSourceRows;
+		oldSourceRows.reserve(oldIndexes.size());
+		for(const auto &oldIndex : oldIndexes)
+			oldSourceRows.append(_proxyToSource[oldIndex.row()]);
+
+		QVector<int> merged(_proxyToSource.size() + sourceRows.size());
+		std::merge(_proxyToSource.constBegin(), _proxyToSource.constEnd(),
+				   sourceRows.constBegin(), sourceRows.constEnd(),
+				   merged.begin(), lessThan);
+		_proxyToSource.swap(merged);
+		updateSourceToProxy(proxyRows.first(), _proxyToSource.size() - 1);
+
+		QModelIndexList newIndexes;
+		newIndexes.reserve(oldIndexes.size());
+		for(auto i = 0; i < oldIndexes.size(); ++i)
+			newIndexes.append(index(_sourceToProxy[oldSourceRows[i]], oldIndexes[i].column()));
+		changePersistentIndexList(oldIndexes, newIndexes);
+		emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+		return;
+	}
+
+	// one insertion per contiguous range, front to back, so every range is inserted at its final row
+	for(auto i = 0; i < proxyRows.size();) {
+		auto last = i;
+		while(last + 1 < proxyRows.size() && proxyRows[last + 1] == proxyRows[last] + 1)
+			++last;
+		beginInsertRows(QModelIndex{}, proxyRows[i], proxyRows[last]);
+		_proxyToSource.insert(proxyRows[i], last - i + 1, -1);
+		for(auto j = i; j <= last; ++j)
+			_proxyToSource[proxyRows[j]] = sourceRows[j];
+		updateSourceToProxy(proxyRows[i], _proxyToSource.size() - 1);
+		endInsertRows();
+		i = last + 1;
+	}
+}
+
+void QObjectSortFilterProxyModel::removeProxyRow(int sourceRow)
+{
+	const auto proxyRow = _sourceToProxy[sourceRow];
+	beginRemoveRows(QModelIndex{}, proxyRow, proxyRow);
+	_proxyToSource.remove(proxyRow);
+	_sourceToProxy[sourceRow] = -1;
+	updateSourceToProxy(proxyRow, _proxyToSource.size() - 1);
+	endRemoveRows();
+}
+
+void QObjectSortFilterProxyModel::repositionProxyRow(int sourceRow)
+{
+	const auto from = _sourceToProxy[sourceRow];
+	if(from == -1)
+		return;
+
+	// binary search the new position, skipping the row itself
+	int destination; // the destination in the coordinates before the move
+	int to;
+	if(from > 0 && rowLessThan(sourceRow, _proxyToSource[from - 1])) {
+		to = insertPosition(sourceRow, 0, from);
+		destination = to;
+	} else if(from < _proxyToSource.size() - 1 && rowLessThan(_proxyToSource[from + 1], sourceRow)) {
+		destination = insertPosition(sourceRow, from + 1, _proxyToSource.size());
+		to = destination - 1;
+	} else
+		return;
+
+	beginMoveRows(QModelIndex{}, from, from, QModelIndex{}, destination);
+	_proxyToSource.move(from, to);
+	updateSourceToProxy(std::min(from, to), std::max(from, to));
+	endMoveRows();
+}
@@ -0,0 +1,79 @@
+#ifndef QOBJECTSORTFILTERPROXYMODEL_H
+#define QOBJECTSORTFILTERPROXYMODEL_H
+
+#include <functional>
+
+#include <QAbstractProxyModel>
+#include <QVector>
+
+class Q_QOBJECT_LIST_MODEL_EXPORT QObjectSortFilterProxyModel : public QAbstractProxyModel
+{
+	Q_OBJECT
+
+public:
+	using LessThanFunc = std::function<bool(const QVariant&, const QVariant&)>;
+	using FilterFunc = std::function<bool(const QAbstractItemModel*, int)>;
+
+	explicit QObjectSortFilterProxyModel(QObject *parent = nullptr);
+
+	QModelIndex index(int row, int column, const QModelIndex &parent = {}) const override;
+	QModelIndex parent(const QModelIndex &child) const override;
+	int rowCount(const QModelIndex &parent = {}) const override;
+	int columnCount(const QModelIndex &parent = {}) const override;
+	QHash<int, QByteArray> roleNames() const override;
+	void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+	void setSourceModel(QAbstractItemModel *sourceModel) override;
+	QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+	QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+	int sortColumn() const;
+	Qt::SortOrder sortOrder() const;
+	int sortRole() const;
+	void setSortRole(int role);
+	void setLessThan(const LessThanFunc &lessThan);
+	void setFilter(const FilterFunc &filter, const QVector<int> &filterRoles = {});
+
+public Q_SLOTS:
+	void invalidate();
+
+private Q_SLOTS:
+	void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+	void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+	void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+	void sourceRowsRemoved(const QModelIndex &parent, int first, int last);
+	void sourceRowsMoved(const QModelIndex &sourceParent, int sourceStart, int sourceEnd, const QModelIndex &destinationParent, int destinationRow);
+	void sourceLayoutAboutToBeChanged();
+	void sourceLayoutChanged();
+	void sourceHeaderDataChanged(Qt::Orientation orientation, int first, int last);
+
+private:
+	int _sortColumn = -1;
+	Qt::SortOrder _sortOrder = Qt::AscendingOrder;
+	int _sortRole = Qt::DisplayRole;
+	LessThanFunc _lessThan;
+	FilterFunc _filter;
+	QVector<int> _filterRoles;
+	QVector<QMetaObject::Connection> _sourceConnections;
+
+	QVector<int> _proxyToSource;
+	QVector<int> _sourceToProxy; // -1 for filtered rows
+	QVector<QVariant> _sortKeys; // index: source row
+	QModelIndexList _layoutProxyIndexes;
+	QList<QPersistentModelIndex> _layoutSourceIndexes; // only set during a source layout change
+
+	QVariant sortKey(int sourceRow) const;
+	bool filterAcceptsRow(int sourceRow) const;
+	bool rowLessThan(int lhsSourceRow, int rhsSourceRow) const;
+	int insertPosition(int sourceRow, int first, int last) const;
+
+	void rebuild();
+	void resort();
+	void finishSourceLayoutChange();
+	void updateSourceToProxy(int firstProxyRow, int lastProxyRow);
+	void insertProxyRows(QVector<int> sourceRows);
+	void removeProxyRow(int sourceRow);
+	void repositionProxyRow(int sourceRow);
+};
+
+#endif // QOBJECTSORTFILTERPROXYMODEL_H
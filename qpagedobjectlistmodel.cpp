@@ -0,0 +1,266 @@
+#include "qpagedobjectlistmodel.h"
+#include <algorithm>
+#include <QMetaProperty>
+#include "qobjectsignalhelper.h"
+
+QPagedObjectListModel::QPagedObjectListModel(const QMetaObject *objectType, bool objectOwner, QObject *parent) :
+	QMetaObjectModel{objectType, parent},
+	_objectOwner{objectOwner},
+	_signalHelper{new QObjectSignalHelper{[this](QObject *object, const QVector<int> &roles) {
+		triggerDataChange(object, roles);
+	}, this}}
+{
+	auto role = Qt::UserRole + 1;
+	for(const auto &property : roleProperties()) {
+		if(property.hasNotifySignal())
+			_signalHelper->addSignal(role, property.notifySignal());
+		++role;
+	}
+}
+
+QPagedObjectListModel::~QPagedObjectListModel()
+{
+	// hand all remaining objects back to the provider
+	evictPages(0, _totalCount / _pageSize);
+}
+
+void QPagedObjectListModel::setProvider(const ProviderFunc &provider, const ReleaseFunc &release)
+{
+	beginResetModel();
+	evictPages(0, _totalCount / _pageSize);
+	_provider = provider;
+	_release = release;
+	_fetchedCount = 0;
+	endResetModel();
+}
+
+int QPagedObjectListModel::totalCount() const
+{
+	return _totalCount;
+}
+
+int QPagedObjectListModel::pageSize() const
+{
+	return _pageSize;
+}
+
+int QPagedObjectListModel::maxPages() const
+{
+	return _maxPages;
+}
+
+int QPagedObjectListModel::loadedPages() const
+{
+	return _pages.size();
+}
+
+bool QPagedObjectListModel::isLoaded(int row) const
+{
+	return _pages.contains(row / _pageSize);
+}
+
+QObject *QPagedObjectListModel::object(const QModelIndex &index) const
+{
+	Q_ASSERT(checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid));
+	return object(index.row());
+}
+
+QObject *QPagedObjectListModel::object(int index) const
+{
+	Q_ASSERT_X(index >= 0 && index < _totalCount, Q_FUNC_INFO, "Row out of range");
+	if(!_provider)
+		return nullptr;
+	// loading a page does not change the logical state of the model
+	const auto &page = const_cast<QPagedObjectListModel*>(this)->loadPage(index / _pageSize);
+	return page.value(index % _pageSize);
+}
+
+int QPagedObjectListModel::rowCount(const QModelIndex &parent) const
+{
+	Q_ASSERT(this->checkIndex(parent, QAbstractItemModel::CheckIndexOption::DoNotUseParent));
+	if (parent.isValid())
+		return 0;
+	else
+		return _fetchedCount;
+}
+
+bool QPagedObjectListModel::canFetchMore(const QModelIndex &parent) const
+{
+	return !parent.isValid() &&
+			_provider &&
+			_fetchedCount < _totalCount;
+}
+
+void QPagedObjectListModel::fetchMore(const QModelIndex &parent)
+{
+	if(!canFetchMore(parent))
+		return;
+
+	// only reveals the rows, the objects are created once they are accessed
+	const auto count = std::min(_pageSize, _totalCount - _fetchedCount);
+	beginInsertRows(QModelIndex{}, _fetchedCount, _fetchedCount + count - 1);
+	_fetchedCount += count;
+	endInsertRows();
+}
+
+QModelIndex QPagedObjectListModel::index(QObject *object) const
+{
+	const auto row = _objectRows.value(object, -1);
+	if(row != -1 && row < _fetchedCount)
+		return index(row, 0);
+	else
+		return {};
+}
+
+void QPagedObjectListModel::setTotalCount(int totalCount)
+{
+	Q_ASSERT_X(totalCount >= 0, Q_FUNC_INFO, "The total count cannot be negative");
+	if(_totalCount == totalCount)
+		return;
+
+	// the page containing the old or new end changes its size -> drop it and everything behind it
+	const auto firstPage = std::min(_totalCount, totalCount) / _pageSize;
+	const auto lastPage = std::max(_totalCount, totalCount) / _pageSize;
+	if(totalCount < _fetchedCount) {
+		beginRemoveRows(QModelIndex{}, totalCount, _fetchedCount - 1);
+		evictPages(firstPage, lastPage);
+		_totalCount = totalCount;
+		_fetchedCount = totalCount;
+		endRemoveRows();
+	} else {
+		evictPages(firstPage, lastPage);
+		_totalCount = totalCount;
+	}
+	emit totalCountChanged(_totalCount, {});
+}
+
+void QPagedObjectListModel::setPageSize(int pageSize)
+{
+	Q_ASSERT_X(pageSize > 0, Q_FUNC_INFO, "The page size must be at least 1");
+	if(_pageSize == pageSize)
+		return;
+
+	evictPages(0, _totalCount / _pageSize);
+	_pageSize = pageSize;
+}
+
+void QPagedObjectListModel::setMaxPages(int maxPages)
+{
+	Q_ASSERT_X(maxPages > 0, Q_FUNC_INFO, "At least one page must be kept loaded");
+	_maxPages = maxPages;
+	trimPages();
+}
+
+void QPagedObjectListModel::resetModel(int totalCount)
+{
+	Q_ASSERT_X(totalCount >= 0, Q_FUNC_INFO, "The total count cannot be negative");
+	beginResetModel();
+	evictPages(0, _totalCount / _pageSize);
+	const auto changed = _totalCount != totalCount;
+	_totalCount = totalCount;
+	_fetchedCount = 0;
+	endResetModel();
+	if(changed)
+		emit totalCountChanged(_totalCount, {});
+}
+
+void QPagedObjectListModel::refreshRows(int first, int count)
+{
+	const auto last = std::min(first + count, _totalCount) - 1;
+	if(first < 0 || last < first)
+		return;
+
+	evictPages(first / _pageSize, last / _pageSize);
+	if(first < _fetchedCount)
+		emitDataChanged(index(first, 0), index(std::min(last, _fetchedCount - 1), 0), {});
+}
+
+QVariant QPagedObjectListModel::readProperty(int row, const QMetaProperty &property) const
+{
+	const auto obj = object(row);
+	if(obj)
+		return property.read(obj);
+	else
+		return {};
+}
+
+bool QPagedObjectListModel::writeProperty(int row, const QMetaProperty &property, const QVariant &data)
+{
+	const auto obj = object(row);
+	if(obj)
+		return property.write(obj, data);
+	else
+		return false;
+}
+
+const QObjectList &QPagedObjectListModel::loadPage(int page)
+{
+	auto it = _pages.find(page);
+	if(it != _pages.end()) {
+		if(_recentPages.last() != page) {
+			_recentPages.removeOne(page);
+			_recentPages.append(page);
+		}
+		return *it;
+	}
+
+	// make room first, so the new page is never evicted right away
+	while(_pages.size() >= _maxPages)
+		evictPage(_recentPages.first());
+
+	const auto first = page * _pageSize;
+	const auto count = std::min(_pageSize, _totalCount - first);
+	auto objects = _provider(first, count);
+	Q_ASSERT_X(objects.size() == count, Q_FUNC_INFO, "The provider must create exactly one object per requested row");
+	for(auto i = 0; i < objects.size(); ++i) {
+		const auto obj = objects[i];
+		_objectRows.insert(obj, first + i);
+		if(_objectOwner)
+			obj->setParent(this);
+		_signalHelper->addObject(obj);
+	}
+	_recentPages.append(page);
+	return *_pages.insert(page, std::move(objects));
+}
+
+void QPagedObjectListModel::evictPage(int page)
+{
+	const auto objects = _pages.take(page);
+	_recentPages.removeOne(page);
+	for(auto obj : objects) {
+		_objectRows.remove(obj);
+		_signalHelper->removeObject(obj);
+		if(_objectOwner && obj->parent() == this) {
+			if(_release)
+				obj->setParent(nullptr);
+			else
+				obj->deleteLater();
+		}
+	}
+	if(_release)
+		_release(page * _pageSize, objects);
+}
+
+void QPagedObjectListModel::evictPages(int firstPage, int lastPage)
+{
+	QVector<int> pages;
+	for(auto it = _pages.constBegin(); it != _pages.constEnd(); ++it) {
+		if(it.key() >= firstPage && it.key() <= lastPage)
+			pages.append(it.key());
+	}
+	for(auto page : qAsConst(pages))
+		evictPage(page);
+}
+
+void QPagedObjectListModel::trimPages()
+{
+	while(_pages.size() > _maxPages)
+		evictPage(_recentPages.first());
+}
+
+void QPagedObjectListModel::triggerDataChange(QObject *object, const QVector<int> &roles)
+{
+	auto mIndex = index(object);
+	if(mIndex.isValid())
+		emitDataChanged(mIndex, mIndex, roles);
+}
@@ -0,0 +1,80 @@
+#ifndef QPAGEDOBJECTLISTMODEL_H
+#define QPAGEDOBJECTLISTMODEL_H
+
+#include <functional>
+
+#include "qmetaobjectmodel.h"
+
+class QObjectSignalHelper;
+class Q_QOBJECT_LIST_MODEL_EXPORT QPagedObjectListModel : public QMetaObjectModel
+{
+	Q_OBJECT
+
+	Q_PROPERTY(int totalCount READ totalCount WRITE setTotalCount NOTIFY totalCountChanged)
+	Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize)
+	Q_PROPERTY(int maxPages READ maxPages WRITE setMaxPages)
+
+public:
+	using ProviderFunc = std::function<QObjectList(int, int)>; // first row, count
+	using ReleaseFunc = std::function<void(int, const QObjectList &)>; // first row, evicted objects
+
+	explicit QPagedObjectListModel(const QMetaObject *objectType,
+								   bool objectOwner = true,
+								   QObject *parent = nullptr);
+	~QPagedObjectListModel() override;
+
+	void setProvider(const ProviderFunc &provider, const ReleaseFunc &release = {});
+
+	int totalCount() const;
+	int pageSize() const;
+	int maxPages() const;
+	int loadedPages() const;
+	bool isLoaded(int row) const;
+
+	QObject *object(const QModelIndex &index) const;
+	Q_INVOKABLE QObject *object(int index) const;
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	bool canFetchMore(const QModelIndex &parent) const override;
+	void fetchMore(const QModelIndex &parent) override;
+	using QMetaObjectModel::index;
+	QModelIndex index(QObject *object) const;
+
+public Q_SLOTS:
+	void setTotalCount(int totalCount);
+	void setPageSize(int pageSize);
+	void setMaxPages(int maxPages);
+	void resetModel(int totalCount);
+	void refreshRows(int first, int count);
+
+Q_SIGNALS:
+	void totalCountChanged(int totalCount, QPrivateSignal);
+
+protected:
+	QVariant readProperty(int row, const QMetaProperty &property) const override;
+	bool writeProperty(int row, const QMetaProperty &property, const QVariant &data) override;
+
+private:
+	bool _objectOwner;
+	ProviderFunc _provider;
+	ReleaseFunc _release;
+	QObjectSignalHelper *_signalHelper;
+
+	int _totalCount = 0;
+	int _fetchedCount = 0;
+	int _pageSize = 100;
+	int _maxPages = 10;
+	QHash<int, QObjectList> _pages; // key: page index
+	QVector<int> _recentPages; // least recently used first
+	QHash<QObject*, int> _objectRows; // only for loaded objects
+
+	const QObjectList &loadPage(int page);
+	void evictPage(int page);
+	void evictPages(int firstPage, int lastPage);
+	void trimPages();
+	void triggerDataChange(QObject *object, const QVector<int> &roles);
+};
+
+Q_DECLARE_METATYPE(QPagedObjectListModel*)
+
+#endif // QPAGEDOBJECTLISTMODEL_H